@@ -0,0 +1,111 @@
+#include "Cello.h"
+
+enum {
+  ITEMS   = 1000000,
+  LOOKUPS = 4000000,
+  REPEATS = 3
+};
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static uint64_t next(uint64_t* x) {
+  *x ^= *x << 13; *x ^= *x >> 7; *x ^= *x << 17;
+  return *x;
+}
+
+static double best(int64_t* times) {
+  int64_t b = times[0];
+  for (size_t i = 1; i < REPEATS; i++) { if (times[i] < b) { b = times[i]; } }
+  return (double)b / LOOKUPS;
+}
+
+static void bench_int(void) {
+
+  var t = new(Table, Int, Int);
+  for (int64_t i = 0; i < ITEMS; i++) {
+    set(t, $I(i * 7), $I(i));
+  }
+
+  int64_t hits[REPEATS], misses[REPEATS];
+  int64_t found = 0;
+
+  for (size_t r = 0; r < REPEATS; r++) {
+
+    uint64_t x = 88172645463325252ull;
+    int64_t start = now_ns();
+    for (int64_t i = 0; i < LOOKUPS; i++) {
+      found += mem(t, $I((next(&x) % ITEMS) * 7));
+    }
+    hits[r] = now_ns() - start;
+
+    start = now_ns();
+    for (int64_t i = 0; i < LOOKUPS; i++) {
+      found += mem(t, $I((next(&x) % ITEMS) * 7 + 1));
+    }
+    misses[r] = now_ns() - start;
+  }
+
+  if (found isnt REPEATS * LOOKUPS) {
+    print("Lookups returned wrong results: %i\n", $I(found));
+  }
+
+  print("* Int hit: %fns per lookup\n", $F(best(hits)));
+  print("* Int miss: %fns per lookup\n", $F(best(misses)));
+
+  del(t);
+}
+
+static void bench_string(void) {
+
+  char** keys = malloc(sizeof(char*) * ITEMS);
+  var t = new(Table, String, Int);
+  for (int64_t i = 0; i < ITEMS; i++) {
+    keys[i] = malloc(32);
+    snprintf(keys[i], 32, "key-%lli-%lli", (long long)i, (long long)(i * 31));
+    set(t, $S(keys[i]), $I(i));
+  }
+
+  int64_t hits[REPEATS], misses[REPEATS];
+  int64_t found = 0;
+  char miss[32];
+
+  for (size_t r = 0; r < REPEATS; r++) {
+
+    uint64_t x = 88172645463325252ull;
+    int64_t start = now_ns();
+    for (int64_t i = 0; i < LOOKUPS; i++) {
+      found += mem(t, $S(keys[next(&x) % ITEMS]));
+    }
+    hits[r] = now_ns() - start;
+
+    start = now_ns();
+    for (int64_t i = 0; i < LOOKUPS; i++) {
+      uint64_t k = next(&x) % ITEMS;
+      memcpy(miss, keys[k], 32);
+      miss[0] = 'K';
+      found += mem(t, $S(miss));
+    }
+    misses[r] = now_ns() - start;
+  }
+
+  if (found isnt REPEATS * LOOKUPS) {
+    print("Lookups returned wrong results: %i\n", $I(found));
+  }
+
+  print("* String hit: %fns per lookup\n", $F(best(hits)));
+  print("* String miss: %fns per lookup\n", $F(best(misses)));
+
+  del(t);
+  for (int64_t i = 0; i < ITEMS; i++) { free(keys[i]); }
+  free(keys);
+}
+
+int main(int argc, char** argv) {
+  bench_int();
+  bench_string();
+  return 0;
+}
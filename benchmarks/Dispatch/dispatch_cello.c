@@ -0,0 +1,108 @@
+#include "Cello.h"
+
+enum {
+  CALLS = 20000000
+};
+
+struct Speak {
+  int64_t (*speak)(var);
+};
+
+var Speak = CelloEmpty(Speak);
+
+struct Animal {
+  int64_t legs;
+};
+
+static int64_t Animal_Speak(var self) {
+  struct Animal* a = self;
+  return a->legs;
+}
+
+static int64_t Bird_Speak(var self) {
+  struct Animal* a = self;
+  return a->legs + 1;
+}
+
+static int Animal_Cmp(var self, var obj) {
+  struct Animal* lhs = self;
+  struct Animal* rhs = obj;
+  return (int)(lhs->legs - rhs->legs);
+}
+
+static uint64_t Animal_Hash(var self) {
+  struct Animal* a = self;
+  return (uint64_t)a->legs;
+}
+
+static int Animal_Show(var self, var out, int pos) {
+  return print_to(out, pos, "<Animal>");
+}
+
+var Dog = CelloObject(Dog, sizeof(struct Animal),
+  Instance(Cmp,   Animal_Cmp),
+  Instance(Hash,  Animal_Hash),
+  Instance(Show,  Animal_Show, NULL),
+  Instance(Speak, Animal_Speak));
+
+var Bird = CelloObject(Bird, sizeof(struct Animal),
+  Instance(Cmp,   Animal_Cmp),
+  Instance(Hash,  Animal_Hash),
+  Instance(Show,  Animal_Show, NULL),
+  Instance(Speak, Bird_Speak));
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int64_t speak_uncached(var self) {
+  return ((struct Speak*)instance(self, Speak))->speak(self);
+}
+
+static int64_t speak(var self) {
+  return method(self, Speak, speak);
+}
+
+int main(int argc, char** argv) {
+  
+  var dog = new(Dog);
+  var bird = new(Bird);
+  ((struct Animal*)dog)->legs = 4;
+  ((struct Animal*)bird)->legs = 1;
+  
+  int64_t check0 = 0, check1 = 0, check2 = 0;
+  
+  int64_t start = now_ns();
+  for (int64_t i = 0; i < CALLS; i++) {
+    check0 += speak_uncached(i & 1 ? bird : dog);
+  }
+  int64_t uncached = now_ns() - start;
+  
+  start = now_ns();
+  for (int64_t i = 0; i < CALLS; i++) {
+    check1 += speak(dog);
+  }
+  int64_t monomorphic = now_ns() - start;
+  
+  start = now_ns();
+  for (int64_t i = 0; i < CALLS; i++) {
+    check2 += speak(i & 1 ? bird : dog);
+  }
+  int64_t polymorphic = now_ns() - start;
+  
+  if (check0 isnt check2) {
+    print("Results differ: %i %i\n", $I(check0), $I(check2));
+    return 1;
+  }
+  
+  print("* Uncached: %fns per call\n",
+    $F((double)uncached / CALLS));
+  print("* Monomorphic: %fns per call\n",
+    $F((double)monomorphic / CALLS));
+  print("* Polymorphic: %fns per call\n",
+    $F((double)polymorphic / CALLS));
+  
+  return check1 is 4 * CALLS ? 0 : 1;
+}
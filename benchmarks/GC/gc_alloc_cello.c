@@ -0,0 +1,36 @@
+#include "Cello.h"
+
+enum {
+  ALLOCATIONS = 5000000,
+  LOOKUPS     = 50000000
+};
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+
+  int64_t start = now_ns();
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    volatile var gc = current(GC);
+    (void)gc;
+  }
+  int64_t lookup = now_ns() - start;
+
+  start = now_ns();
+  for (size_t i = 0; i < ALLOCATIONS; i++) {
+    new(Int, $I(i));
+  }
+  int64_t allocation = now_ns() - start;
+
+  print("* current(GC): %fns per lookup\n",
+    $F((double)lookup / LOOKUPS));
+  print("* new(Int): %fns per allocation, %f million per second\n",
+    $F((double)allocation / ALLOCATIONS),
+    $F((double)ALLOCATIONS / allocation * 1e3));
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "Cello.h"
+
+enum {
+  REQUESTS    = 10000,
+  TEMPORARIES = 500
+};
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int64_t request(int64_t n) {
+  var items = new(Array, Ref);
+  for (int64_t i = 0; i < TEMPORARIES; i++) {
+    push(items, $R(new(Int, $I(n + i))));
+  }
+  int64_t total = 0;
+  foreach (r in items) { total += c_int(deref(r)); }
+  return total;
+}
+
+int main(int argc, char** argv) {
+
+  int64_t check0 = 0, check1 = 0;
+
+  int64_t start = now_ns();
+  for (int64_t i = 0; i < REQUESTS; i++) {
+    check0 += request(i);
+  }
+  int64_t collected = now_ns() - start;
+
+  start = now_ns();
+  for (int64_t i = 0; i < REQUESTS; i++) {
+    with (a in new(Arena)) {
+      check1 += request(i);
+    }
+  }
+  int64_t arena = now_ns() - start;
+
+  if (check0 isnt check1) {
+    print("Results differ: %i %i\n", $I(check0), $I(check1));
+    return 1;
+  }
+
+  print("* Collected: %fus per request\n",
+    $F((double)collected / REQUESTS / 1e3));
+  print("* Arena: %fus per request\n",
+    $F((double)arena / REQUESTS / 1e3));
+
+  return 0;
+}
@@ -33,6 +33,11 @@ static void create_objects(int depth) {
 
 int main(int argc, char** argv) {
   
+  /* Pass "calloc" to compare against allocating without the slabs */
+  if (argc > 1 and strcmp(argv[1], "calloc") is 0) {
+    rem(current(GC), GCSlab);
+  }
+  
   for (size_t i = 0; i < 100; i++) {
     create_objects(0);
   }
@@ -0,0 +1,52 @@
+#include "Cello.h"
+
+enum {
+  LIVE_ARRAYS  = 1000,
+  LIVE_ITEMS   = 1000,
+  TEMP_OBJECTS = 600000
+};
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void run(var live, int threads) {
+
+  var gc = current(GC);
+  set(gc, GCThreads, $I(threads));
+
+  /* Longest allocation is the full collection which rescans `live` */
+  int64_t longest = 0;
+  for (size_t i = 0; i < TEMP_OBJECTS; i++) {
+    int64_t t0 = now_ns();
+    new(Int, $I(i));
+    int64_t t1 = now_ns() - t0;
+    if (t1 > longest) { longest = t1; }
+  }
+
+  print("* %i threads: max pause %fms\n",
+    $I(threads), $F((double)longest / 1e6));
+
+  rem(gc, GCThreads);
+}
+
+int main(int argc, char** argv) {
+
+  var live = new(Array, Ref);
+  for (size_t i = 0; i < LIVE_ARRAYS; i++) {
+    var items = new(Array, Ref);
+    for (size_t j = 0; j < LIVE_ITEMS; j++) {
+      push(items, $R(new(Int, $I(j))));
+    }
+    push(live, $R(items));
+  }
+
+  run(live, 1);
+  run(live, 2);
+  run(live, 4);
+  run(live, 8);
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "Cello.h"
+
+enum {
+  LIVE_OBJECTS = 200000,
+  TEMP_OBJECTS = 1000000,
+  PAUSE_NS     = 10000
+};
+
+static int64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void run(const char* label,
+  bool generational, bool incremental, bool sweeper) {
+
+  var gc = current(GC);
+  if (generational) {
+    set(gc, GCGenerational, $I(1));
+  } else {
+    rem(gc, GCGenerational);
+  }
+  if (incremental) {
+    set(gc, GCIncremental, $I(1000));
+  } else {
+    rem(gc, GCIncremental);
+  }
+  if (sweeper) {
+    set(gc, GCSweeper, $I(1));
+  } else {
+    rem(gc, GCSweeper);
+  }
+
+  /* Long lived heap which a full collection rescans every time */
+  var live = new(Array, Box);
+  for (size_t i = 0; i < LIVE_OBJECTS; i++) {
+    push(live, $B(new(Int, $I(i))));
+  }
+
+  int64_t pauses = 0, total = 0, longest = 0, start = now_ns();
+
+  for (size_t i = 0; i < TEMP_OBJECTS; i++) {
+    int64_t t0 = now_ns();
+    new(Int, $I(i));
+    int64_t t1 = now_ns() - t0;
+    if (t1 > PAUSE_NS) { pauses++; total += t1; }
+    if (t1 > longest) { longest = t1; }
+  }
+
+  int64_t elapsed = now_ns() - start;
+
+  print("* %s: %i pauses, mean %fms, max %fms, total %fs\n",
+    $S((char*)label), $I(pauses),
+    $F(pauses ? (double)total / pauses / 1e6 : 0.0),
+    $F((double)longest / 1e6), $F((double)elapsed / 1e9));
+
+  del(live);
+}
+
+int main(int argc, char** argv) {
+  run("Full", false, false, false);
+  run("Generational", true, false, false);
+  run("Incremental", false, true, false);
+  run("Sweeper", false, false, true);
+  return 0;
+}
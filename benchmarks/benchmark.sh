@@ -3,39 +3,46 @@ gcc ./ext/genint.c -o ./ext/genint
 
 gcc Nbodies/nbodies_c.c -std=c99 -O3 -lm -o Nbodies/nbodies_c
 g++ Nbodies/nbodies_cpp.cpp -std=c++11 -O3 -lm -o Nbodies/nbodies_cpp
-cc Nbodies/nbodies_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -std=gnu99  -O3 -lm -lpthread -o Nbodies/nbodies_cello
+cc Nbodies/nbodies_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99  -O3 -lm -lpthread -o Nbodies/nbodies_cello
 javac Nbodies/nbodies_java.java
 
 gcc List/list_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o List/list_c
 g++ List/list_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o List/list_cpp
-cc List/list_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o List/list_cello
+cc List/list_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o List/list_cello
 javac List/list_java.java
 
 gcc Dict/dict_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o Dict/dict_c
 g++ Dict/dict_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o Dict/dict_cpp
-cc Dict/dict_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Dict/dict_cello
+cc Dict/dict_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Dict/dict_cello
+cc Dict/dict_lookup_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Dict/dict_lookup_cello
 javac Dict/dict_java.java
 
 gcc Map/map_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o Map/map_c
 g++ Map/map_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o Map/map_cpp
-cc Map/map_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Map/map_cello
+cc Map/map_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Map/map_cello
 javac Map/map_java.java
 
 gcc Sudoku/sudoku_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o Sudoku/sudoku_c
 g++ Sudoku/sudoku_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o Sudoku/sudoku_cpp
-cc Sudoku/sudoku_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Sudoku/sudoku_cello
+cc Sudoku/sudoku_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Sudoku/sudoku_cello
 javac Sudoku/sudoku_java.java
 
 gcc Matmul/matmul_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o Matmul/matmul_c
 g++ Matmul/matmul_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o Matmul/matmul_cpp
-cc Matmul/matmul_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Matmul/matmul_cello
+cc Matmul/matmul_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -Wno-unused-result -std=gnu99  -O3 -lm -lpthread -o Matmul/matmul_cello
 javac Matmul/matmul_java.java
 
 gcc GC/gc_c.c -Wno-unused-result -I./ext -std=c99 -O3 -lm -o GC/gc_c
 g++ GC/gc_cpp.cpp -Wno-unused-result -std=c++11 -O3 -lm -o GC/gc_cpp
-cc GC/gc_cello.c -DCELLO_NDEBUG ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_cello
+cc GC/gc_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_cello
+cc GC/gc_pause_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_pause_cello
+cc GC/gc_parallel_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_parallel_cello
+cc GC/gc_alloc_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_alloc_cello
+cc GC/gc_arena_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o GC/gc_arena_cello
 javac GC/gc_java.java
 
+cc Dispatch/dispatch_cello.c -DCELLO_NDEBUG -flto ../libCello.a -I../include -std=gnu99 -O3 -lm -lpthread -o Dispatch/dispatch_cello
+
 echo 
 echo "## Garbage Collection"
 echo
@@ -45,6 +52,8 @@ printf "* C++: "
 gtime -f "%e" -f "%e" ./GC/gc_cpp
 printf "* Cello: "
 gtime -f "%e" -f "%e" ./GC/gc_cello
+printf "* Cello (calloc): "
+gtime -f "%e" -f "%e" ./GC/gc_cello calloc
 printf "* Java: "
 gtime -f "%e" -f "%e" java -cp ./GC gc_java
 printf "* Javascript: "
@@ -61,6 +70,31 @@ gtime -f "%e" -f "%e" lua GC/gc_lua.lua
 # gprof GC/gc_cello > GC/profile.txt
 # rm gmon.out
 
+echo 
+echo "## Garbage Collection Pauses"
+echo
+./GC/gc_pause_cello
+
+echo
+echo "## Parallel Marking"
+echo
+./GC/gc_parallel_cello
+
+echo
+echo "## Allocation Throughput"
+echo
+./GC/gc_alloc_cello
+
+echo
+echo "## Arena Allocation"
+echo
+./GC/gc_arena_cello
+
+echo
+echo "## Method Dispatch"
+echo
+./Dispatch/dispatch_cello
+
 
 echo 
 echo "## List"
@@ -162,6 +196,11 @@ gtime -f "%e" -f "%e" sh -c './ext/genint | lua Dict/dict_lua.lua'
 # gprof Dict/dict_cello > Dict/profile.txt
 # rm gmon.out
 
+echo
+echo "## Dict Lookups"
+echo
+./Dict/dict_lookup_cello
+
 echo 
 echo "## Sudoku"
 echo
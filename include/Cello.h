@@ -64,11 +64,8 @@
 
 #ifndef CELLO_CACHE
 #define CELLO_CACHE 1
-#define CELLO_CACHE_HEADER \
-  NULL, NULL, NULL, NULL, NULL, NULL, \
-  NULL, NULL, NULL, NULL, NULL, NULL, \
-  NULL, NULL, NULL, NULL, NULL, NULL,
-#define CELLO_CACHE_NUM 18
+#define CELLO_CACHE_HEADER NULL, NULL, NULL,
+#define CELLO_CACHE_NUM 3
 #else
 #define CELLO_CACHE 0
 #define CELLO_CACHE_HEADER
@@ -113,6 +110,39 @@
 # define CELLO_NASAN
 #endif
 
+#if defined __GNUC__ || defined __clang__
+# define CELLO_PREFETCH(x) __builtin_prefetch(x)
+#else
+# define CELLO_PREFETCH(x)
+#endif
+
+#if defined __GNUC__ || defined __clang__
+# define CELLO_CALLER __builtin_return_address(0)
+#else
+# define CELLO_CALLER NULL
+#endif
+
+#if defined __GNUC__ || defined __clang__
+# define CELLO_TLS __thread
+#elif defined CELLO_MSC
+# define CELLO_TLS __declspec(thread)
+#endif
+
+#if (defined __GNUC__ || defined __clang__) \
+  && !defined __TINYC__ && !defined CELLO_NINLINE_CACHE
+# define CELLO_INLINE_CACHE 1
+#else
+# define CELLO_INLINE_CACHE 0
+#endif
+
+#if defined CELLO_NDEBUG && CELLO_CACHE == 1 \
+  && (defined __GNUC__ || defined __clang__) \
+  && !defined __TINYC__ && !defined CELLO_NINLINE
+# define CELLO_INLINE 1
+#else
+# define CELLO_INLINE 0
+#endif
+
 /* Includes */
 
 #include <stdio.h>
@@ -177,6 +207,7 @@ extern var Tuple;
 
 extern var Ref;
 extern var Box;
+extern var Weak;
 extern var Int;
 extern var Float;
 extern var String;
@@ -198,6 +229,7 @@ extern var Mutex;
 extern var Thread;
 extern var Process;
 extern var Function;
+extern var Arena;
 
 extern var Exception;
 extern var IOError;
@@ -222,7 +254,8 @@ extern var ProgramTerminationError;
 
 enum {
   AllocStatic = 0x01, AllocStack = 0x02,
-  AllocHeap   = 0x03, AllocData  = 0x04
+  AllocHeap   = 0x03, AllocData  = 0x04,
+  AllocArena  = 0x05
 };
 
 struct Header {
@@ -235,6 +268,24 @@ struct Header {
 #endif
 };
 
+struct InlineCache {
+  size_t version;
+  var type;
+  var inst;
+};
+
+enum {
+  CELLO_CACHE_ID    = 0,
+  CELLO_CACHE_TABLE = 1,
+  CELLO_CACHE_NAME  = 2
+};
+
+struct TypeTable {
+  struct TypeTable* prev;
+  size_t size;
+  var insts[];
+};
+
 struct Type {
   var cls;
   var name;
@@ -249,6 +300,10 @@ struct Box {
   var val;
 };
 
+struct Weak {
+  var val;
+};
+
 struct Int {
   int64_t val;
 };
@@ -305,6 +360,15 @@ struct Function {
   var (*func)(var);
 };
 
+struct Arena {
+  var prev;
+  struct ArenaChunk* chunks;
+  char* ptr;
+  char* end;
+  size_t size;
+  bool running;
+};
+
 /* Classes */
 
 extern var Doc;
@@ -337,6 +401,8 @@ extern var Current;
 extern var Start;
 extern var Lock;
 extern var Mark;
+extern var Finalize;
+extern var Layout;
 
 /* Signatures */
 
@@ -506,6 +572,14 @@ struct Mark {
   void (*mark)(var, var, void(*)(var,void*));
 };
 
+struct Finalize {
+  void (*finalize)(var);
+};
+
+struct Layout {
+  uint64_t (*layout)(void);
+};
+
 /* Functions */
 
 const char* name(var type);
@@ -523,16 +597,49 @@ bool implements(var self, var cls);
 var type_instance(var type, var cls);
 bool type_implements(var type, var cls);
 
+#if CELLO_INLINE == 1
+
+/*
+**  In the inline profile `method` reads the type's dispatch table
+**  directly, which is no more work than checking a call site cache,
+**  so call site caches are only used by `type_method` there.
+*/
+
+#define method(X, C, M, ...) method_inline(X, C, M, ##__VA_ARGS__)
+
+#elif CELLO_INLINE_CACHE == 1
+
+#define method(X, C, M, ...) ({ \
+  static struct InlineCache __cello_cache; \
+  var __cello_self = (X); \
+  ((struct C*)method_at_offset_inline(&__cello_cache, __cello_self, C, \
+  offsetof(struct C, M), #M))->M(__cello_self, ##__VA_ARGS__); })
+
+#else
+
 #define method(X, C, M, ...) \
   ((struct C*)method_at_offset(X, C, \
   offsetof(struct C, M), #M))->M(X, ##__VA_ARGS__)
 
-#define implements_method(X, C, M) \
-  implements_method_at_offset(X, C, offsetof(struct C, M))
-  
+#endif
+
+#if CELLO_INLINE_CACHE == 1
+
+#define type_method(T, C, M, ...) ({ \
+  static struct InlineCache __cello_cache; \
+  ((struct C*)type_method_at_offset_inline(&__cello_cache, T, C, \
+  offsetof(struct C, M), #M))->M(__VA_ARGS__); })
+
+#else
+
 #define type_method(T, C, M, ...) \
   ((struct C*)type_method_at_offset(T, C, \
   offsetof(struct C, M), #M))->M(__VA_ARGS__)
+
+#endif
+
+#define implements_method(X, C, M) \
+  implements_method_at_offset(X, C, offsetof(struct C, M))
   
 #define type_implements_method(T, C, M) \
   type_implements_method_at_offset(T, C, offsetof(struct C, M))
@@ -543,6 +650,57 @@ bool implements_method_at_offset(var self, var cls, size_t offset);
 var type_method_at_offset(var self, var cls, size_t offset, const char* method);
 bool type_implements_method_at_offset(var self, var cls, size_t offset);
 
+#if CELLO_INLINE_CACHE == 1
+
+/*
+**  Each `method` and `type_method` call site owns an `InlineCache` which
+**  remembers the last type dispatched on and the class instance it found.
+**  The pair is guarded by a seqlock: the version is odd while a writer is
+**  updating it, and a reader only uses the pair if it saw the same even
+**  version before and after loading it, so a torn read always misses.
+*/
+
+var method_at_offset_cached(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method);
+var type_method_at_offset_cached(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method);
+
+static inline var inline_cache_get(struct InlineCache* cache, var type) {
+  size_t version = __atomic_load_n(&cache->version, __ATOMIC_ACQUIRE);
+  var curr = __atomic_load_n(&cache->type, __ATOMIC_RELAXED);
+  var inst = __atomic_load_n(&cache->inst, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  if (type is NULL or curr isnt type or (version & 1)
+  or  __atomic_load_n(&cache->version, __ATOMIC_RELAXED) isnt version) {
+    return NULL;
+  }
+  return inst;
+}
+
+static inline var method_at_offset_inline(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method) {
+  var inst = NULL;
+  if (self isnt NULL) {
+    struct Header* head = 
+      (struct Header*)((char*)self - sizeof(struct Header));
+#if CELLO_MAGIC_CHECK == 1
+    if (head->magic is ((var)CELLO_MAGIC_NUM))
+#endif
+    inst = inline_cache_get(cache, head->type);
+  }
+  return inst isnt NULL ? inst :
+    method_at_offset_cached(cache, self, cls, offset, method);
+}
+
+static inline var type_method_at_offset_inline(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method) {
+  var inst = inline_cache_get(cache, self);
+  return inst isnt NULL ? inst :
+    type_method_at_offset_cached(cache, self, cls, offset, method);
+}
+
+#endif
+
 struct Header* header(var self);
 var header_init(var head, var type, int alloc);
 
@@ -567,11 +725,16 @@ void dealloc_root(var self);
 #define $S(X) $(String, X)
 #define $R(X) $(Ref, X)
 #define $B(X) $(Box, X)
+#define $W(X) $(Weak, X)
 
 #define tuple(...) tuple_xp(tuple_in, (_, ##__VA_ARGS__, Terminal))
 #define tuple_xp(X, A) X A
 #define tuple_in(_, ...) $(Tuple, (var[]){ __VA_ARGS__ })
 
+size_t args_len(var args);
+var args_get(var args, size_t i);
+var args_at(var args, size_t n, size_t i);
+
 #define construct(self, ...) construct_with(self, tuple(__VA_ARGS__))
 var construct_with(var self, var args);
 var destruct(var self);
@@ -584,6 +747,10 @@ var new_with(var type, var args);
 var new_raw_with(var type, var args);
 var new_root_with(var type, var args);
 
+var new_int(int64_t val);
+var new_float(double val);
+var new_str(const char* val);
+
 void del(var self);
 void del_raw(var self);
 void del_root(var self);
@@ -602,6 +769,7 @@ bool le(var self, var obj);
 
 uint64_t hash(var self);
 uint64_t hash_data(const void* data, size_t num);
+uint64_t hash_mix(uint64_t h);
 
 var iter_init(var self);
 var iter_next(var self, var curr);
@@ -752,9 +920,50 @@ var exception_message(void);
 
 void mark(var self, var gc, void(*f)(var,void*));
 
+#define layout_of(T, F) ((uint64_t)1 << (offsetof(struct T, F) / sizeof(var)))
+
 #ifndef CELLO_NGC
 
 extern var GC;
+extern var GCGenerational;
+extern var GCNursery;
+extern var GCIncremental;
+extern var GCTimeBudget;
+extern var GCThreads;
+extern var GCSweeper;
+extern var GCSlab;
+extern var GCGrowth;
+extern var GCMinHeap;
+extern var GCMaxBytes;
+extern var GCProfile;
+
+struct GCStats {
+  size_t collections;
+  size_t minor_collections;
+  size_t pauses;
+  uint64_t pause_total;
+  uint64_t pause_max;
+  size_t pause_histogram[16];
+  size_t objects_allocated;
+  size_t objects_freed;
+  size_t bytes_allocated;
+  size_t bytes_freed;
+  size_t objects;
+  size_t pages;
+  double load_factor;
+  size_t stack_size;
+};
+
+void gc_barrier(var self);
+var gc_alloc(var gc, size_t size);
+void gc_collect(var gc);
+var gc_handoff(var gc, var obj);
+var gc_adopt(var gc, var obj);
+var gc_find(var gc, bool (*f)(var ptr, var ctx), var ctx);
+void gc_site(var gc, var obj, void* site);
+void gc_snapshot(var gc, var out);
+void gc_stats(var gc, struct GCStats* stats);
+void gc_hook(var gc, void (*f)(var gc, bool end));
 
 // C-friendly GC memory management functions
 void* gc_malloc(size_t size);
@@ -786,6 +995,125 @@ void Cello_Exit(void);
 
 #endif
 
+#if CELLO_INLINE == 1
+
+/*
+**  In release builds the hottest functions are also given inline
+**  definitions, so that user code can dispatch straight through the
+**  dispatch table of the type instead of calling into the library.
+**  Looking up a class which has never been seen on that type, or any
+**  other case the table cannot answer, falls through to the normal out
+**  of line functions. Because these are `gnu_inline` the library still
+**  provides the real symbols. Define `CELLO_NINLINE` to turn this off.
+*/
+
+#define CELLO_INLINE_FN extern inline __attribute__((gnu_inline))
+
+#define type_of_inline(X) \
+  (((struct Header*)((char*)(X) - sizeof(struct Header)))->type)
+
+#define instance_inline(X, C) ({ \
+  var* __cello_type = type_of_inline(X); \
+  size_t __cello_id = (size_t)__atomic_load_n( \
+    &((var*)(C))[CELLO_CACHE_ID], __ATOMIC_RELAXED); \
+  struct TypeTable* __cello_table = __cello_type is NULL ? NULL : \
+    __atomic_load_n((struct TypeTable**)&__cello_type[CELLO_CACHE_TABLE], \
+    __ATOMIC_ACQUIRE); \
+  __cello_table isnt NULL and __cello_id < __cello_table->size ? \
+    __atomic_load_n(&__cello_table->insts[__cello_id], __ATOMIC_RELAXED) \
+    : NULL; })
+
+#define method_inline(X, C, M, ...) ({ \
+  var __cello_self = (X); \
+  struct C* __cello_inst = instance(__cello_self, C); \
+  if (__cello_inst is NULL or __cello_inst->M is NULL) { \
+    __cello_inst = method_at_offset(__cello_self, C, \
+      offsetof(struct C, M), #M); \
+  } \
+  __cello_inst->M(__cello_self, ##__VA_ARGS__); })
+
+CELLO_INLINE_FN var instance(var self, var cls) {
+  var inst = instance_inline(self, cls);
+  if (inst is NULL) { return type_instance(type_of(self), cls); }
+  return inst isnt Terminal ? inst : NULL;
+}
+
+CELLO_INLINE_FN uint64_t hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+CELLO_INLINE_FN uint64_t hash(var self) {
+  struct Hash* h = instance(self, Hash);
+  if (h and h->hash) { return h->hash(self); }
+  return hash_data(self, size(type_of(self)));
+}
+
+CELLO_INLINE_FN bool eq(var self, var obj) {
+  struct Cmp* c = instance(self, Cmp);
+  if (c and c->cmp) { return c->cmp(self, obj) is 0; }
+  return cmp(self, obj) is 0;
+}
+
+CELLO_INLINE_FN bool neq(var self, var obj) {
+  return not eq(self, obj);
+}
+
+CELLO_INLINE_FN size_t len(var self) {
+  return method_inline(self, Len, len);
+}
+
+CELLO_INLINE_FN var get(var self, var key) {
+  return method_inline(self, Get, get, key);
+}
+
+CELLO_INLINE_FN void set(var self, var key, var val) {
+  method_inline(self, Get, set, key, val);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
+}
+
+CELLO_INLINE_FN bool mem(var self, var key) {
+  return method_inline(self, Get, mem, key);
+}
+
+CELLO_INLINE_FN void push(var self, var val) {
+  method_inline(self, Push, push, val);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
+}
+
+CELLO_INLINE_FN var iter_init(var self) {
+  return method_inline(self, Iter, iter_init);
+}
+
+CELLO_INLINE_FN var iter_next(var self, var curr) {
+  return method_inline(self, Iter, iter_next, curr);
+}
+
+CELLO_INLINE_FN char* c_str(var self) {
+  if (type_of_inline(self) is String) { return ((struct String*)self)->val; }
+  return method_inline(self, C_Str, c_str);
+}
+
+CELLO_INLINE_FN int64_t c_int(var self) {
+  if (type_of_inline(self) is Int) { return ((struct Int*)self)->val; }
+  return method_inline(self, C_Int, c_int);
+}
+
+CELLO_INLINE_FN double c_float(var self) {
+  if (type_of_inline(self) is Float) { return ((struct Float*)self)->val; }
+  return method_inline(self, C_Float, c_float);
+}
+
+#endif
+
 /* Include all standard library headers */
 #include "Math.h"
 #include "Collections.h"
@@ -0,0 +1,2 @@
+#include "h.h"
+size_t len(void* self) { return self ? *(size_t*)self + 1000 : 0; }
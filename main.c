@@ -0,0 +1,3 @@
+#include <stdio.h>
+#include "h.h"
+int main(void) { size_t x = 5; size_t (*f)(void*) = len; printf("%zu %zu\n", len(&x), f(&x)); return 0; }
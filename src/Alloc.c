@@ -33,7 +33,9 @@ static const char* Alloc_Description(void) {
   return
     "The `Alloc` class can be used to override how memory is allocated for a "
     "given data type. By default memory is allocated using `calloc` along with "
-    "the `Size` class to determine the amount of memory to allocate."
+    "the `Size` class to determine the amount of memory to allocate. Small "
+    "objects registered with the Garbage Collector are instead allocated from "
+    "a per thread slab allocator owned by the collector."
     "\n\n"
     "A custom allocator should be careful to also initialise the header for "
     "the allocated memory using the function `header_init`. Cello objects "
@@ -118,20 +120,332 @@ var Alloc = Cello(Alloc, Instance(Doc,
   Alloc_Name,       Alloc_Brief,    Alloc_Description, 
   Alloc_Definition, Alloc_Examples, Alloc_Methods));
 
+static const char* Arena_Name(void) {
+  return "Arena";
+}
+
+static const char* Arena_Brief(void) {
+  return "Region Allocation";
+}
+
+static const char* Arena_Description(void) {
+  return
+    "The `Arena` type provides region based allocation. While an `Arena` is "
+    "started every object allocated on that thread with `alloc` or `new` is "
+    "placed in memory owned by the `Arena` using a simple bump pointer, and "
+    "is not registered with the Garbage Collector. When the `Arena` is "
+    "stopped all of these objects are destructed and their memory is released "
+    "in one go. This makes it a good fit for use with the `with` macro around "
+    "a block of code which creates many temporary objects that all die "
+    "together."
+    "\n\n"
+    "While an `Arena` is started the objects inside of it are treated as roots "
+    "by the Garbage Collector, so they may safely refer to collected objects. "
+    "Nothing which outlives the `Arena` may keep a reference to them however. "
+    "In debug builds stopping an `Arena` searches the heap and throws a "
+    "`ResourceError` if any object allocated inside of it has escaped, in "
+    "which case its memory is kept rather than released. In release builds, "
+    "or when compiled without the Garbage Collector, this check is skipped "
+    "and any reference which escapes is left dangling once the `Arena` is "
+    "stopped. Objects created with `new_raw` or `new_root` are never placed "
+    "in an `Arena` and so can be used to keep results around after the end "
+    "of the block."
+    "\n\n"
+    "Arenas can be nested, in which case the one started most recently is "
+    "used. Objects in an `Arena` must not be deleted manually. As with a "
+    "`Mutex`, if an exception is thrown out of a `with` block the `Arena` is "
+    "not stopped automatically and `stop` must be called by hand.";
+}
+
+static const char* Arena_Definition(void) {
+  return
+    "struct Arena {\n"
+    "  var prev;\n"
+    "  struct ArenaChunk* chunks;\n"
+    "  char* ptr;\n"
+    "  char* end;\n"
+    "  size_t size;\n"
+    "  bool running;\n"
+    "};\n";
+}
+
+static struct Example* Arena_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "with (a in new(Arena)) {\n"
+      "  var x = new(Int, $I(10));\n"
+      "  var y = new(String, $S(\"Hello\"));\n"
+      "  show(x); /* 10 */\n"
+      "  show(y); /* Hello */\n"
+      "} /* x and y released here */\n"
+    }, {
+      "Keeping Results",
+      "var total = new_root(Int, $I(0));\n"
+      "\n"
+      "with (a in new(Arena)) {\n"
+      "  var items = new(Array, Int, $I(1), $I(2), $I(3));\n"
+      "  foreach (i in items) {\n"
+      "    assign(total, $I(c_int(total) + c_int(i)));\n"
+      "  }\n"
+      "}\n"
+      "\n"
+      "show(total); /* 6 */\n"
+      "del_root(total);\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+}
+
+#define ARENA_TLS_KEY "__Arena"
+
+enum {
+  ARENA_ALIGN = 2 * sizeof(var),
+  ARENA_CHUNK_MIN = 4096,
+  ARENA_CHUNK_MAX = 1 << 20
+};
+
+struct ArenaChunk {
+  struct ArenaChunk* next;
+  char* top;
+};
+
+#ifdef CELLO_TLS
+static CELLO_TLS struct Arena* Arena_Local = NULL;
+#endif
+
+static var Arena_Current(void) {
+#ifdef CELLO_TLS
+  return Arena_Local;
+#else
+  var t = current(Thread);
+  return mem(t, $S(ARENA_TLS_KEY)) ? get(t, $S(ARENA_TLS_KEY)) : NULL;
+#endif
+}
+
+static void Arena_Set_Current(struct Arena* a) {
+  if (a isnt NULL) {
+    set(current(Thread), $S(ARENA_TLS_KEY), a);
+  } else {
+    rem(current(Thread), $S(ARENA_TLS_KEY));
+  }
+#ifdef CELLO_TLS
+  Arena_Local = a;
+#endif
+}
+
+static size_t Arena_Round(size_t size) {
+  return (size + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+}
+
+static char* Arena_Data(struct ArenaChunk* c) {
+  return (char*)c + Arena_Round(sizeof(struct ArenaChunk));
+}
+
+static char* Arena_Top(struct Arena* a, struct ArenaChunk* c) {
+  return c is a->chunks ? a->ptr : c->top;
+}
+
+static size_t Arena_Step(char* head) {
+  var self = head + sizeof(struct Header);
+  return Arena_Round(sizeof(struct Header) + size(type_of(self)));
+}
+
+static void Arena_New(var self, var args) {
+  struct Arena* a = self;
+  (void)args;
+  a->prev = NULL;
+  a->chunks = NULL;
+  a->ptr = NULL;
+  a->end = NULL;
+  a->size = ARENA_CHUNK_MIN;
+  a->running = false;
+}
+
+static void Arena_Grow(struct Arena* a, size_t size) {
+
+  if (a->chunks isnt NULL) { a->chunks->top = a->ptr; }
+
+  size_t n = size > a->size ? size : a->size;
+  struct ArenaChunk* c = calloc(1, Arena_Round(sizeof(struct ArenaChunk)) + n);
+
+#if CELLO_MEMORY_CHECK == 1
+  if (c is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate Arena memory, out of memory!");
+  }
+#endif
+
+  c->next = a->chunks;
+  c->top = Arena_Data(c);
+  a->chunks = c;
+  a->ptr = Arena_Data(c);
+  a->end = a->ptr + n;
+  a->size = a->size * 2 < ARENA_CHUNK_MAX ? a->size * 2 : ARENA_CHUNK_MAX;
+}
+
+static var Arena_Alloc(struct Arena* a, size_t size) {
+  size = Arena_Round(size);
+  if ((size_t)(a->end - a->ptr) < size) { Arena_Grow(a, size); }
+  var ptr = a->ptr;
+  a->ptr += size;
+  return ptr;
+}
+
+#ifndef CELLO_NGC
+#if CELLO_ALLOC_CHECK == 1
+static bool Arena_Contains(var ptr, var chunks) {
+  for (struct ArenaChunk* c = chunks; c isnt NULL; c = c->next) {
+    if ((char*)ptr >= Arena_Data(c) and (char*)ptr < c->top) { return true; }
+  }
+  return false;
+}
+#endif
+#endif
+
+/*
+**  Every object is destructed before any chunk is freed so that
+**  destructors may still look at other objects in the arena.
+*/
+
+static void Arena_Release(struct ArenaChunk* chunks) {
+
+  for (struct ArenaChunk* c = chunks; c isnt NULL; c = c->next) {
+    for (char* h = Arena_Data(c); h < c->top; h += Arena_Step(h)) {
+      destruct(h + sizeof(struct Header));
+    }
+  }
+
+  while (chunks isnt NULL) {
+    struct ArenaChunk* next = chunks->next;
+    free(chunks);
+    chunks = next;
+  }
+
+}
+
+static void Arena_Start(var self) {
+  struct Arena* a = self;
+  
+  if (a->running) {
+    throw(ResourceError, "Arena %$ has already been started!", self);
+  }
+  
+  a->prev = Arena_Current();
+  a->running = true;
+  Arena_Set_Current(a);
+}
+
+static void Arena_Stop(var self) {
+  struct Arena* a = self;
+  
+  if (not a->running) { return; }
+  
+  if (Arena_Current() isnt self) {
+    throw(ResourceError,
+      "Arena %$ must be stopped before those started inside of it!", self);
+  }
+  
+  Arena_Set_Current(a->prev);
+  a->prev = NULL;
+  a->running = false;
+  
+  if (a->chunks is NULL) { return; }
+  
+  struct ArenaChunk* chunks = a->chunks;
+  chunks->top = a->ptr;
+  a->chunks = NULL;
+  a->ptr = NULL;
+  a->end = NULL;
+  a->size = ARENA_CHUNK_MIN;
+
+#if CELLO_ALLOC_CHECK == 1
+#ifndef CELLO_NGC
+  if (gc_find(current(GC), Arena_Contains, chunks) isnt NULL) {
+    throw(ResourceError,
+      "Object allocated in Arena %$ is still referenced after stop!", self);
+  }
+#endif
+#endif
+  
+  Arena_Release(chunks);
+}
+
+static bool Arena_Running(var self) {
+  struct Arena* a = self;
+  return a->running;
+}
+
+static void Arena_Del(var self) {
+  struct Arena* a = self;
+  if (a->running and Arena_Current() is self) { Arena_Set_Current(a->prev); }
+  if (a->chunks is NULL) { return; }
+  a->chunks->top = a->ptr;
+  Arena_Release(a->chunks);
+}
+
+static void Arena_Mark(var self, var gc, void(*f)(var,void*)) {
+  struct Arena* a = self;
+  
+  /* Enclosing arenas are marked too, which may be old */
+  if (a->prev isnt NULL) {
+    f(gc, a->prev);
+    mark(a->prev, gc, f);
+  }
+
+  for (struct ArenaChunk* c = a->chunks; c isnt NULL; c = c->next) {
+    char* top = Arena_Top(a, c);
+    for (char* h = Arena_Data(c); h < top; h += Arena_Step(h)) {
+      f(gc, h + sizeof(struct Header));
+    }
+  }
+}
+
+var Arena = Cello(Arena,
+  Instance(Doc,
+    Arena_Name,       Arena_Brief,    Arena_Description, 
+    Arena_Definition, Arena_Examples, NULL),
+  Instance(New,      Arena_New, Arena_Del),
+  Instance(Start,    Arena_Start, Arena_Stop, NULL, Arena_Running),
+  Instance(Mark,     Arena_Mark),
+  Instance(Current,  Arena_Current));
+
 enum {
   ALLOC_STANDARD,
   ALLOC_RAW,
   ALLOC_ROOT
 };
   
-static var alloc_by(var type, int method) {
+static var alloc_by(var type, int method, void* site) {
   
   struct Alloc* a = type_instance(type, Alloc);
   var self;
   if (a and a->alloc) {
     self = a->alloc();
   } else {
-    struct Header* head = calloc(1, sizeof(struct Header) + size(type));  
+    
+    struct Header* head = NULL;
+    
+    /* Objects in a started Arena are not seen by the Garbage Collector */
+    if (method is ALLOC_STANDARD and type isnt Arena) {
+      struct Arena* arena = Arena_Current();
+      if (arena isnt NULL) {
+        head = Arena_Alloc(arena, sizeof(struct Header) + size(type));
+        return header_init(head, type, AllocArena);
+      }
+    }
+    
+    /* Small collected objects come from the slab allocator */
+#ifndef CELLO_NGC
+    if (method is ALLOC_STANDARD) {
+      head = gc_alloc(current(GC), sizeof(struct Header) + size(type));
+    }
+#endif
+    
+    if (head is NULL) {
+      head = calloc(1, sizeof(struct Header) + size(type));
+    }
 
 #if CELLO_MEMORY_CHECK == 1
     if (head is NULL) {
@@ -146,12 +460,14 @@ static var alloc_by(var type, int method) {
     case ALLOC_STANDARD:
 #ifndef CELLO_NGC
     set(current(GC), self, $I(0));
+    gc_site(current(GC), self, site);
 #endif
     break;
     case ALLOC_RAW: break;
     case ALLOC_ROOT:
 #ifndef CELLO_NGC
     set(current(GC), self, $I(1));
+    gc_site(current(GC), self, site);
 #endif
     break;
   }
@@ -159,9 +475,9 @@ static var alloc_by(var type, int method) {
   return self;
 }
 
-var alloc(var type)      { return alloc_by(type, ALLOC_STANDARD); }
-var alloc_raw(var type)  { return alloc_by(type, ALLOC_RAW); }
-var alloc_root(var type) { return alloc_by(type, ALLOC_ROOT); }
+var alloc(var type)      { return alloc_by(type, ALLOC_STANDARD, CELLO_CALLER); }
+var alloc_raw(var type)  { return alloc_by(type, ALLOC_RAW, NULL); }
+var alloc_root(var type) { return alloc_by(type, ALLOC_ROOT, CELLO_CALLER); }
 
 void dealloc(var self) {
 
@@ -193,6 +509,12 @@ void dealloc(var self) {
       "Attempt to deallocate %$ "
       "which was allocated inside a data structure!", self); 
   }
+  
+  if (header(self)->alloc is (var)AllocArena) {
+    throw(ResourceError,
+      "Attempt to deallocate %$ "
+      "which was allocated inside an Arena!", self); 
+  }
 #endif
   
 #if CELLO_ALLOC_CHECK == 1
@@ -318,8 +640,8 @@ var construct_with(var self, var args) {
   struct New* n = instance(self, New);
   if (n and n->construct_with) {
     n->construct_with(self, args);
-  } else if (len(args) == 1) {
-    assign(self, get(args, $I(0)));
+  } else if (args_len(args) == 1) {
+    assign(self, args_get(args, 0));
   }
   return self;
 }
@@ -333,7 +655,7 @@ var destruct(var self) {
 }
 
 var new_with(var type, var args) {
-  return construct_with(alloc(type), args);
+  return construct_with(alloc_by(type, ALLOC_STANDARD, CELLO_CALLER), args);
 }
 
 var new_raw_with(var type, var args) { 
@@ -341,7 +663,7 @@ var new_raw_with(var type, var args) {
 }
 
 var new_root_with(var type, var args) { 
-  return construct_with(alloc_root(type), args);
+  return construct_with(alloc_by(type, ALLOC_ROOT, CELLO_CALLER), args);
 }
 
 static void del_by(var self, int method) {
@@ -441,6 +763,6 @@ var copy(var self) {
     return c->copy(self); 
   }
   
-  return assign(alloc(type_of(self)), self);
+  return assign(alloc_by(type_of(self), ALLOC_STANDARD, CELLO_CALLER), self);
   
 }
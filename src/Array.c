@@ -106,9 +106,9 @@ static size_t Array_Size_Round(size_t s) {
 static void Array_New(var self, var args) {
   
   struct Array* a = self;
-  a->type   = cast(get(args, $I(0)), Type);
+  a->type   = cast(args_get(args, 0), Type);
   a->tsize  = Array_Size_Round(size(a->type));
-  a->nitems = len(args)-1;
+  a->nitems = args_len(args)-1;
   a->nslots = a->nitems;
   
   if (a->nslots is 0) {
@@ -126,7 +126,7 @@ static void Array_New(var self, var args) {
   
   for(size_t i = 0; i < a->nitems; i++) {
     Array_Alloc(a, i);
-    assign(Array_Item(a, i), get(args, $I(i+1)));  
+    assign(Array_Item(a, i), args_at(args, a->nitems+1, i+1));  
   }
   
 }
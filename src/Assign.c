@@ -78,12 +78,19 @@ var assign(var self, var obj) {
   
   if (a and a->assign) {
     a->assign(self, obj);
+#ifndef CELLO_NGC
+    gc_barrier(self);
+#endif
     return self;
   }
   
   size_t s = size(type_of(self));
   if (type_of(self) is type_of(obj) and s) {
-    return memcpy(self, obj, s);
+    memcpy(self, obj, s);
+#ifndef CELLO_NGC
+    gc_barrier(self);
+#endif
+    return self;
   }
   
   return throw(TypeError,
@@ -167,12 +174,20 @@ void swap(var self, var obj) {
   struct Swap* s = instance(self, Swap);
   if (s and s->swap) {
     s->swap(self, obj);
+#ifndef CELLO_NGC
+    gc_barrier(self);
+    gc_barrier(obj);
+#endif
     return;
   }
   
   size_t n = size(type_of(self));
   if (type_of(self) is type_of(obj) and n) {
     memswap(self, obj, n);
+#ifndef CELLO_NGC
+    gc_barrier(self);
+    gc_barrier(obj);
+#endif
     return;
   }
   
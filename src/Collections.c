@@ -18,6 +18,12 @@ static bool collections_initialized = false;
 #define DEFAULT_CAPACITY 16
 #define LOAD_FACTOR_THRESHOLD 0.75
 
+// Set and HashMap capacities are powers of two, so slots are found by
+// masking a finalized hash instead of dividing by the capacity.
+static uint64_t collections_slot_hash(var item) {
+    return hash_mix(collections_hash(item));
+}
+
 // Stack implementation
 static void Stack_New(var self, var args) {
     struct Stack* s = cast(self, Stack);
@@ -250,7 +256,7 @@ static void BinaryTree_New(var self, var args) {
     t->size = 0;
     t->compare = NULL;
     
-    if (len(args) > 0) {
+    if (args_len(args) > 0) {
         // First argument should be comparison function
         // For now, use default comparison
         t->compare = (int(*)(var,var))collections_default_compare;
@@ -476,8 +482,7 @@ var set_new(void) {
 
 static size_t set_hash_index(var self, var item) {
     struct Set* s = cast(self, Set);
-    uint64_t h = hash(item);
-    return h % s->capacity;
+    return collections_slot_hash(item) & (s->capacity - 1);
 }
 
 void set_add(var self, var item) {
@@ -486,7 +491,7 @@ void set_add(var self, var item) {
     
     // Linear probing
     while (s->buckets[idx] && !eq(s->buckets[idx], item)) {
-        idx = (idx + 1) % s->capacity;
+        idx = (idx + 1) & (s->capacity - 1);
     }
     
     if (!s->buckets[idx]) {
@@ -510,7 +515,7 @@ void set_remove(var self, var item) {
             s->num_items--;
             return;
         }
-        idx = (idx + 1) % s->capacity;
+        idx = (idx + 1) & (s->capacity - 1);
     }
 }
 
@@ -522,7 +527,7 @@ bool set_contains(var self, var item) {
         if (eq(s->buckets[idx], item)) {
             return true;
         }
-        idx = (idx + 1) % s->capacity;
+        idx = (idx + 1) & (s->capacity - 1);
     }
     return false;
 }
@@ -539,8 +544,7 @@ var hashmap_new(void) {
 
 static size_t hashmap_hash_index(var self, var key) {
     struct HashMap* h = cast(self, HashMap);
-    uint64_t hash_val = hash(key);
-    return hash_val % h->capacity;
+    return collections_slot_hash(key) & (h->capacity - 1);
 }
 
 void hashmap_put(var self, var key, var value) {
@@ -549,7 +553,7 @@ void hashmap_put(var self, var key, var value) {
     
     // Linear probing
     while (h->occupied[idx] && !eq(h->keys[idx], key)) {
-        idx = (idx + 1) % h->capacity;
+        idx = (idx + 1) & (h->capacity - 1);
     }
     
     if (!h->occupied[idx]) {
@@ -569,7 +573,7 @@ var hashmap_get(var self, var key) {
         if (eq(h->keys[idx], key)) {
             return h->values[idx];
         }
-        idx = (idx + 1) % h->capacity;
+        idx = (idx + 1) & (h->capacity - 1);
     }
     return NULL;
 }
@@ -584,7 +588,7 @@ void hashmap_remove(var self, var key) {
             h->size--;
             return;
         }
-        idx = (idx + 1) % h->capacity;
+        idx = (idx + 1) & (h->capacity - 1);
     }
 }
 
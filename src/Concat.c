@@ -68,8 +68,14 @@ var Concat = Cello(Concat,
 
 void append(var self, var obj) {
   method(self, Concat, append, obj);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
 }
 
 void concat(var self, var obj) {
   method(self, Concat, concat, obj);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
 }
@@ -118,6 +118,10 @@ static struct Example* Exception_Examples(void) {
   
 }
 
+#ifdef CELLO_TLS
+static CELLO_TLS struct Exception* Exception_Local = NULL;
+#endif
+
 static void Exception_New(var self, var args) {
   struct Exception* e = self;
   e->active = false;
@@ -126,12 +130,18 @@ static void Exception_New(var self, var args) {
   e->msg = new_raw(String);
   memset(e->buffers, 0, sizeof(jmp_buf*) * EXCEPTION_MAX_DEPTH);
   set(current(Thread), $S(EXCEPTION_TLS_KEY), self);
+#ifdef CELLO_TLS
+  Exception_Local = e;
+#endif
 }
 
 static void Exception_Del(var self) {
   struct Exception* e = self;
   del_raw(e->msg);
   rem(current(Thread), $S(EXCEPTION_TLS_KEY));
+#ifdef CELLO_TLS
+  if (Exception_Local is e) { Exception_Local = NULL; }
+#endif
 }
 
 static void Exception_Assign(var self, var obj) {
@@ -145,6 +155,9 @@ static void Exception_Assign(var self, var obj) {
 }
 
 static var Exception_Current(void) {
+#ifdef CELLO_TLS
+  if (Exception_Local isnt NULL) { return Exception_Local; }
+#endif
   return get(current(Thread), $S(EXCEPTION_TLS_KEY));
 }
 
@@ -391,7 +404,7 @@ var exception_catch(var args) {
   if (not e->active) { return NULL; }
   
   /* If no Arguments catch all */
-  if (len(args) is 0) {
+  if (args_len(args) is 0) {
     return e->obj;
   }
   
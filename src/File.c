@@ -186,8 +186,8 @@ static void File_Close(var self);
 
 static void File_New(var self, var args) {
   struct File* f = self;
-  if (len(args) > 0) {
-    File_Open(self, get(args, $I(0)), get(args, $I(1)));
+  if (args_len(args) > 0) {
+    File_Open(self, args_get(args, 0), args_get(args, 1));
   }
 }
 
@@ -325,6 +325,10 @@ static int File_Format_From(var self, int pos, const char* fmt, va_list va) {
   return vfscanf(f->file, fmt, va);
 }
 
+static uint64_t File_Layout(void) {
+  return 0;
+}
+
 var File = Cello(File,
   Instance(Doc,
     File_Name,       File_Brief,    File_Description, 
@@ -334,7 +338,8 @@ var File = Cello(File,
   Instance(Stream,
     File_Open, File_Close, File_Seek, File_Tell,
     File_Flush, File_EOF, File_Read, File_Write),
-  Instance(Format, File_Format_To, File_Format_From));
+  Instance(Format, File_Format_To, File_Format_From),
+  Instance(Layout, File_Layout));
 
 
 static const char* Process_Name(void) {
@@ -385,7 +390,7 @@ static void Process_Close(var self);
 static void Process_New(var self, var args) {
   struct Process* p = self;
   p->proc = NULL;
-  Process_Open(self, get(args, $I(0)), get(args, $I(1)));
+  Process_Open(self, args_get(args, 0), args_get(args, 1));
 }
 
 static void Process_Del(var self) {
@@ -522,6 +527,10 @@ static int Process_Format_From(var self, int pos, const char* fmt, va_list va) {
   return vfscanf(p->proc, fmt, va);
 }
 
+static uint64_t Process_Layout(void) {
+  return 0;
+}
+
 var Process = Cello(Process,
   Instance(Doc,
     Process_Name,       Process_Brief,    Process_Description, 
@@ -531,5 +540,6 @@ var Process = Cello(Process,
   Instance(Stream,
     Process_Open,  Process_Close, Process_Seek, Process_Tell,
     Process_Flush, Process_EOF,   Process_Read, Process_Write),
-  Instance(Format, Process_Format_To, Process_Format_From));
+  Instance(Format, Process_Format_To, Process_Format_From),
+  Instance(Layout, Process_Layout));
 
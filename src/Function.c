@@ -134,10 +134,15 @@ static var Function_Call(var self, var args) {
   return f->func(args);
 }
 
+static uint64_t Function_Layout(void) {
+  return 0;
+}
+
 var Function = Cello(Function,
   Instance(Doc,
     Function_Name,       Function_Brief,    Function_Description,
     Function_Definition, Function_Examples, NULL),
-  Instance(Call, Function_Call));
+  Instance(Call, Function_Call),
+  Instance(Layout, Function_Layout));
 
 
@@ -53,22 +53,135 @@ void mark(var self, var gc, void(*f)(var,void*)) {
   if (m and m->mark) { m->mark(self, gc, f); }
 }
 
+static const char* Finalize_Name(void) {
+  return "Finalize";
+}
+
+static const char* Finalize_Brief(void) {
+  return "Thread Safe Destruction";
+}
+
+static const char* Finalize_Description(void) {
+  return
+    "The `Finalize` class can be implemented by a type to tell the Garbage "
+    "Collector that it may be destructed on a different thread. When the "
+    "background sweeper is enabled with `GCSweeper` unreachable objects of "
+    "such types are handed over to the sweeper thread, which calls "
+    "`finalize` in place of the usual destructor and then releases the "
+    "memory."
+    "\n\n"
+    "The `finalize` function must only release resources owned by the object "
+    "itself. It must not access other Cello objects or use any thread local "
+    "state such as exceptions or the Garbage Collector.";
+}
+
+static const char* Finalize_Definition(void) {
+  return
+    "struct Finalize {\n"
+    "  void (*finalize)(var);\n"
+    "};\n";
+}
+
+static struct Method* Finalize_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "finalize", 
+      "void finalize(var self);",
+      "Release the resources owned by `self` from any thread."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+var Finalize = Cello(Finalize, Instance(Doc, 
+  Finalize_Name,       Finalize_Brief, Finalize_Description, 
+  Finalize_Definition, NULL,           Finalize_Methods));
+
+static const char* Layout_Name(void) {
+  return "Layout";
+}
+
+static const char* Layout_Brief(void) {
+  return "Pointer Fields";
+}
+
+static const char* Layout_Description(void) {
+  return
+    "The `Layout` class tells the Garbage Collector which fields of a type "
+    "may hold pointers to Cello objects. The `layout` function returns a "
+    "bitmap in which bit `i` is set if the `i`th pointer sized word of the "
+    "structure is such a field. The last bit covers every word from there to "
+    "the end of the structure. Types which hold no Cello objects return `0` "
+    "and are never scanned."
+    "\n\n"
+    "The bits for each field can be built using the `layout_of` macro, which "
+    "takes the name of the structure and field. Types which implement "
+    "neither `Layout` nor `Mark` have every word scanned conservatively.";
+}
+
+static const char* Layout_Definition(void) {
+  return
+    "struct Layout {\n"
+    "  uint64_t (*layout)(void);\n"
+    "};\n";
+}
+
+static struct Example* Layout_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "struct Node {\n"
+      "  int64_t count;\n"
+      "  var left;\n"
+      "  var right;\n"
+      "};\n"
+      "\n"
+      "static uint64_t Node_Layout(void) {\n"
+      "  return layout_of(Node, left) | layout_of(Node, right);\n"
+      "}\n"
+      "\n"
+      "var Node = Cello(Node, Instance(Layout, Node_Layout));\n"
+    }, {NULL, NULL}
+  };
+  
+  return examples;
+}
+
+static struct Method* Layout_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "layout_of", 
+      "#define layout_of(T, F)",
+      "Return the `Layout` bit for the field `F` of the structure `T`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
+var Layout = Cello(Layout, Instance(Doc, 
+  Layout_Name,       Layout_Brief,    Layout_Description, 
+  Layout_Definition, Layout_Examples, Layout_Methods));
+
 #ifndef CELLO_NGC
   
 #define GC_TLS_KEY "__GC"
 
-enum {
-  GC_PRIMES_COUNT = 24
-};
-
-static const size_t GC_Primes[GC_PRIMES_COUNT] = {
-  0,       1,       5,       11,
-  23,      53,      101,     197,
-  389,     683,     1259,    2417,
-  4733,    9371,    18617,   37097,
-  74093,   148073,  296099,  592019,
-  1100009, 2200013, 4400021, 8800019
-};
+var GCGenerational = CelloEmpty(GCGenerational);
+var GCNursery = CelloEmpty(GCNursery);
+var GCIncremental = CelloEmpty(GCIncremental);
+var GCTimeBudget = CelloEmpty(GCTimeBudget);
+var GCThreads = CelloEmpty(GCThreads);
+var GCSweeper = CelloEmpty(GCSweeper);
+var GCSlab = CelloEmpty(GCSlab);
+var GCGrowth = CelloEmpty(GCGrowth);
+var GCMinHeap = CelloEmpty(GCMinHeap);
+var GCMaxBytes = CelloEmpty(GCMaxBytes);
+var GCProfile = CelloEmpty(GCProfile);
 
 static const char* GC_Name(void) {
   return "GC";
@@ -84,7 +197,96 @@ static const char* GC_Description(void) {
     "instance of this type is created for each thread and can be retrieved "
     "using the `current` function. The Garbage Collector can be stopped and "
     "started using `start` and `stop` and objects can be added or removed from "
-    "the Garbage Collector using `set` and `rem`.";
+    "the Garbage Collector using `set` and `rem`."
+    "\n\n"
+    "Collector options are set using `set` with one of the option keys as the "
+    "key. Setting `GCGenerational` to a non-zero value switches the collector "
+    "into generational mode. In this mode new objects are placed in a "
+    "_nursery_ which is collected on its own every time `GCNursery` new "
+    "objects have been allocated. Objects which survive a nursery collection "
+    "are promoted to the old generation, which is only collected when the "
+    "whole heap grows past its usual threshold. Option keys can be checked "
+    "with `mem` and cleared with `rem`."
+    "\n\n"
+    "Old objects which are written to using Cello functions such as `set`, "
+    "`push` or `assign` are recorded in a _remembered set_ so that any "
+    "young objects they reference survive a nursery collection. Code which "
+    "writes pointers to Cello objects directly into the fields of an old "
+    "object must call `gc_barrier` on that object afterwards."
+    "\n\n"
+    "Setting `GCIncremental` to a non-zero value switches the collector into "
+    "incremental mode. Rather than pausing the program for a whole "
+    "collection, each allocation performs a small slice of marking or "
+    "sweeping. The value gives the number of objects processed per slice, "
+    "and `GCTimeBudget` can additionally limit each slice to a number of "
+    "microseconds. Calling `join` on the collector finishes any collection "
+    "which is in progress. Incremental mode relies on the same write barrier "
+    "as generational mode."
+    "\n\n"
+    "Setting `GCThreads` to a value greater than one creates a pool of helper "
+    "threads which mark large heaps in parallel during stop-the-world "
+    "collections. Parallel marking is only available on Unix systems when "
+    "compiled with GCC or Clang. Elsewhere the option is accepted but "
+    "marking remains serial."
+    "\n\n"
+    "Unreachable objects are not destructed during the collection pause. "
+    "Instead they are queued and each following allocation destructs and "
+    "frees a small number of them. Setting `GCSweeper` to a non-zero value "
+    "additionally starts a background thread which finalizes and frees "
+    "objects whose type implements `Finalize`. This option is only "
+    "available on Unix systems."
+    "\n\n"
+    "Small objects are allocated from per thread slabs of equally sized "
+    "slots rather than with `calloc`. Empty slab pages are returned to the "
+    "system at the end of each collection. Removing `GCSlab` makes new "
+    "objects use `calloc` instead."
+    "\n\n"
+    "A full collection is triggered once the number of objects has grown by "
+    "the factor `GCGrowth` since the last one, which defaults to `1.5`, but "
+    "never before there are `GCMinHeap` objects. Setting `GCMaxBytes` adds a "
+    "soft ceiling on the number of bytes held by objects. Crossing it also "
+    "triggers a collection, and if more than this is still live afterwards "
+    "the ceiling is raised by the growth factor. Calling `gc_collect` runs a "
+    "full collection straight away, and calling `resize` on the collector "
+    "with a number of objects prepares it for bulk loading that many new "
+    "objects without collecting or growing its page index."
+    "\n\n"
+    "Pointers stored in a `Weak` are not followed when marking and are "
+    "cleared once the object they point to is collected. A `Table` or `Tree` "
+    "with `Weak` keys only keeps each value alive while its key is alive, "
+    "and its entries are removed once their keys are collected."
+    "\n\n"
+    "Objects are owned by the collector of the thread which created them. "
+    "To pass objects to another thread, call `gc_handoff` with an object. "
+    "This removes it, and every object it reaches which the collector owns, "
+    "from the collector without freeing them. The receiving thread then "
+    "calls `gc_adopt` with the same object to take ownership of them all. "
+    "Neither call copies any objects. Once handed off, the objects must not "
+    "be used by the sending thread. Roots are never handed off."
+    "\n\n"
+    "The function `gc_stats` fills a `struct GCStats` with counters for the "
+    "collector. These include the number of collections, the total and "
+    "longest pause in nanoseconds, and a histogram of pause lengths where "
+    "bucket `i` counts pauses shorter than `2^i` microseconds. They also "
+    "include the objects and bytes allocated and freed, the live object and "
+    "page counts, the load factor of the page index, and the size in bytes "
+    "of the last stack scan. A pause is any stretch of collector work done "
+    "during an allocation."
+    "\n\n"
+    "Setting `GCProfile` to a non-zero value records the address of the "
+    "code which allocates each new object. Calling `gc_snapshot` with an "
+    "output stream such as a `File` or `String` writes a summary of the heap "
+    "to it, giving the number of objects and bytes for each type and for "
+    "each allocation site, and an estimate of the bytes retained by each "
+    "type. The estimate charges every object to the first object found "
+    "referring to it. Entries are sorted by name, so two snapshots taken at "
+    "different times can be compared with `diff`. Sizes only include the "
+    "objects themselves and not memory they allocate internally."
+    "\n\n"
+    "A hook can be installed with `gc_hook`. It is called with `end` set to "
+    "`false` when a collection starts and with `end` set to `true` once the "
+    "dead objects have been found. The collector is stopped while the hook "
+    "runs, so it should not allocate Cello objects.";
 }
 
 static struct Example* GC_Examples(void) {
@@ -98,6 +300,56 @@ static struct Example* GC_Examples(void) {
       "show($I(running(gc))); /* 0 */\n"
       "del(x); /* Must be deleted when done */\n"
       "start(gc);\n"
+    }, {
+      "Generational Mode",
+      "var gc = current(GC);\n"
+      "set(gc, GCGenerational, $I(1));\n"
+      "set(gc, GCNursery, $I(10000));\n"
+      "show($I(mem(gc, GCGenerational))); /* 1 */\n"
+      "rem(gc, GCGenerational);\n"
+    }, {
+      "Incremental Mode",
+      "var gc = current(GC);\n"
+      "set(gc, GCIncremental, $I(500));\n"
+      "set(gc, GCTimeBudget, $I(100));\n"
+      "/* ... */\n"
+      "join(gc); /* Finish current collection */\n"
+      "rem(gc, GCIncremental);\n"
+    }, {
+      "Parallel Marking",
+      "var gc = current(GC);\n"
+      "set(gc, GCThreads, $I(4));\n"
+      "/* ... */\n"
+      "rem(gc, GCThreads);\n"
+    }, {
+      "Background Sweeper",
+      "var gc = current(GC);\n"
+      "set(gc, GCSweeper, $I(1));\n"
+      "/* ... */\n"
+      "rem(gc, GCSweeper);\n"
+    }, {
+      "Heap Growth",
+      "var gc = current(GC);\n"
+      "set(gc, GCGrowth, $F(2.0));\n"
+      "set(gc, GCMinHeap, $I(100000));\n"
+      "set(gc, GCMaxBytes, $I(64 * 1024 * 1024));\n"
+      "resize(gc, 1000000); /* Before loading many objects */\n"
+      "gc_collect(gc);\n"
+    }, {
+      "Statistics",
+      "struct GCStats stats;\n"
+      "gc_stats(current(GC), &stats);\n"
+      "print(\"%i collections, longest pause %ins\\n\",\n"
+      "  $I(stats.collections), $I(stats.pause_max));\n"
+    }, {
+      "Heap Snapshot",
+      "var gc = current(GC);\n"
+      "set(gc, GCProfile, $I(1));\n"
+      "/* ... */\n"
+      "var f = new(File, $S(\"heap.txt\"), $S(\"w\"));\n"
+      "gc_collect(gc);\n"
+      "gc_snapshot(gc, f);\n"
+      "del(f);\n"
     }, {NULL, NULL}
   };
 
@@ -105,439 +357,2906 @@ static struct Example* GC_Examples(void) {
   
 }
 
-struct GCEntry {
+#if defined(CELLO_UNIX) && (defined(__GNUC__) || defined(__clang__))
+#define GC_PARALLEL
+#include <sched.h>
+#endif
+
+#ifdef CELLO_UNIX
+#define GC_SWEEPER
+#endif
+
+enum {
+  GC_NURSERY_DEFAULT = 4096,
+  GC_MIN_HEAP        = 4096,
+  GC_RESERVE_SLOTS   = 4,
+  GC_BUDGET_CLOCK    = 64,
+  GC_PREFETCH        = 8,
+  GC_STEAL           = 256,
+  GC_PARALLEL_MIN    = 4096,
+  GC_INDEX_MIN       = 64,
+  GC_LAZY            = 64,
+  GC_SLAB_ALIGN      = 16,
+  GC_SLAB_MAX        = 256,
+  GC_SLAB_CLASSES    = GC_SLAB_MAX / GC_SLAB_ALIGN,
+  GC_SLAB_PAGES      = 16,
+  GC_HISTOGRAM       = 16,
+  GC_BATCHES         = 256
+};
+
+/*
+**  Registered objects are tracked by the page of memory they
+**  start in. Each page has a set of side bitmaps with one bit per
+**  pointer sized slot, recording where objects start and whether
+**  they are marked, roots, old or dirty. Pages are found using a
+**  small hash index keyed on the page number, so checking if a
+**  pointer is a Cello object is a single probe and a bit test,
+**  and marking only ever writes to the mark bitmap.
+**
+**  Objects found unreachable are moved from `objects` into
+**  `dying` until they are destructed, and then into `dead`
+**  until their memory is freed. They still count towards the
+**  page so their address can not be reused in the meantime.
+**
+**  Small objects are allocated from slab pages owned by the
+**  collector. A slab page is an aligned page which is split into
+**  equal sized slots of one size class, and its free slots are
+**  kept on a list threaded through the slots themselves. Slab
+**  pages are carved out of larger chunks which are returned to
+**  the system in bulk at the end of each sweep once all of their
+**  pages are empty.
+*/
+
+enum {
+  GC_PAGE_SHIFT = 12,
+  GC_PAGE_SIZE  = 1 << GC_PAGE_SHIFT,
+  GC_PAGE_SLOTS = GC_PAGE_SIZE / sizeof(var),
+  GC_PAGE_WORDS = GC_PAGE_SLOTS / 64
+};
+
+struct GCPage {
+  uintptr_t page;
+  size_t index;
+  size_t count;
+  uint64_t objects[GC_PAGE_WORDS];
+  uint64_t marks[GC_PAGE_WORDS];
+  uint64_t roots[GC_PAGE_WORDS];
+  uint64_t old[GC_PAGE_WORDS];
+  uint64_t dirty[GC_PAGE_WORDS];
+  uint64_t dying[GC_PAGE_WORDS];
+  uint64_t dead[GC_PAGE_WORDS];
+  size_t slab;
+  size_t used;
+  bool listed;
+  var free;
+  struct GCPage* next;
+  struct GCChunk* chunk;
+  struct GCChunk* remote;
+  void** sites;
+};
+
+struct GCChunk {
+  char* data;
+  size_t index;
+  size_t used;
+  size_t lent;
+  bool orphan;
+  var returned;
+};
+
+struct GCLent {
   var ptr;
-  uint64_t hash;
-  bool root;
-  bool marked;
+  struct GCChunk* chunk;
+};
+
+struct GCBatch {
+  var root;
+  size_t nitems;
+  size_t mitems;
+  struct GCLent* items;
+  struct GCBatch* next;
+};
+
+struct GCSpare {
+  uintptr_t page;
+  struct GCChunk* chunk;
+};
+
+#ifdef GC_SWEEPER
+
+struct GCFinal {
+  var self;
+  void (*finalize)(var);
+  struct GCPage* slab;
+};
+
+#endif
+
+#ifdef GC_PARALLEL
+
+struct GCWorker {
+  struct GC* gc;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  size_t round;
+  size_t head;
+  size_t nitems;
+  size_t mitems;
+  var* items;
+  var scanning;
+  size_t nweak;
+  size_t mweak;
+  var* weak;
+};
+
+#endif
+
+enum {
+  GC_IDLE,
+  GC_MARKING,
+  GC_SWEEPING
 };
 
 struct GC {
-  struct GCEntry* entries;
-  size_t nslots;
+  struct GCPage** pages;
+  size_t npages;
+  size_t mpages;
+  struct GCPage** index;
+  size_t nindex;
+  size_t mindex;
   size_t nitems;
   size_t mitems;
+  size_t bytes;
+  size_t mbytes;
+  size_t max_bytes;
+  size_t min_heap;
+  double growth;
   uintptr_t maxptr;
   uintptr_t minptr;
+  bool slab;
+  struct GCPage* slabs[GC_SLAB_CLASSES];
+  size_t nchunks;
+  size_t mchunks;
+  struct GCChunk** chunks;
+  size_t nspare;
+  size_t mspare;
+  struct GCSpare* spare;
+  size_t lent;
   var bottom;
   bool running;
-  uintptr_t freenum;
-  var* freelist;
+  size_t ndying;
+  size_t mdying;
+  size_t cdying;
+  var* dying;
+  size_t ndead;
+  size_t mdead;
+  size_t cdead;
+  var* dead;
+  bool generational;
+  bool minor;
+  bool barrier;
+  size_t nursery;
+  size_t nyoung;
+  size_t myoung;
+  var* young;
+  size_t nremembered;
+  size_t mremembered;
+  var* remembered;
+  int phase;
+  bool stepping;
+  size_t budget;
+  size_t budget_time;
+  size_t ngray;
+  size_t mgray;
+  var* gray;
+  size_t nfetch;
+  size_t fetchhead;
+  var fetch[GC_PREFETCH];
+  size_t nallocated;
+  size_t mallocated;
+  var* allocated;
+  var scanning;
+  size_t nweak;
+  size_t mweak;
+  var* weak;
+  size_t nthreads;
+  bool profile;
+  struct GCStats stats;
+  void (*hook)(var, bool);
+#ifdef GC_PARALLEL
+  struct GCWorker* workers;
+  pthread_mutex_t pool_lock;
+  pthread_cond_t pool_wake;
+  pthread_cond_t pool_done;
+  size_t round;
+  size_t nbusy;
+  size_t nidle;
+  bool shutdown;
+#endif
+#ifdef GC_SWEEPER
+  bool sweeper;
+  bool sweep_stop;
+  pthread_t sweep_thread;
+  pthread_mutex_t sweep_lock;
+  pthread_cond_t sweep_wake;
+  size_t nsweep;
+  size_t msweep;
+  struct GCFinal* sweep;
+  size_t nhandoff;
+  size_t mhandoff;
+  struct GCFinal* handoff;
+  size_t nreturned;
+  size_t mreturned;
+  var* returned;
+#endif
 };
 
-static uint64_t GC_Probe(struct GC* gc, uint64_t i, uint64_t h) {
-  int64_t v = i - (h-1);
-  if (v < 0) {
-    v = gc->nslots + v;
+/*
+**  Without a native thread local, finding the current GC from a
+**  write barrier is a lookup in the thread storage, so a count of
+**  the GCs which need the barrier lets every other write skip it.
+*/
+
+#ifndef CELLO_TLS
+static size_t GC_Barrier_Count = 0;
+#endif
+
+static size_t GC_Slot(var ptr) {
+  return ((uintptr_t)ptr & (GC_PAGE_SIZE - 1)) / sizeof(var);
+}
+
+static var GC_Slot_Ptr(struct GCPage* p, size_t i) {
+  return (var)((p->page << GC_PAGE_SHIFT) + i * sizeof(var));
+}
+
+static bool GC_Bit(uint64_t* bits, size_t i) {
+  return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+static void GC_Bit_Set(uint64_t* bits, size_t i) {
+  bits[i / 64] |= (uint64_t)1 << (i % 64);
+}
+
+static void GC_Bit_Clear(uint64_t* bits, size_t i) {
+  bits[i / 64] &= ~((uint64_t)1 << (i % 64));
+}
+
+static void GC_Bit_Put(uint64_t* bits, size_t i, bool v) {
+  if (v) { GC_Bit_Set(bits, i); } else { GC_Bit_Clear(bits, i); }
+}
+
+static struct GCPage* GC_Page(struct GC* gc, uintptr_t page) {
+  size_t mask = gc->nindex - 1;
+  size_t i = hash_mix(page) & mask;
+  while (gc->index[i] isnt NULL) {
+    if (gc->index[i]->page is page) { return gc->index[i]; }
+    i = (i+1) & mask;
   }
-  return v;
+  return NULL;
 }
 
-static const double GC_Load_Factor = 0.9;
+static void GC_Index_Put(struct GC* gc, struct GCPage* p) {
+  size_t mask = gc->nindex - 1;
+  size_t i = hash_mix(p->page) & mask;
+  while (gc->index[i] isnt NULL) { i = (i+1) & mask; }
+  gc->index[i] = p;
+}
+
+static void GC_Index_Resize(struct GC* gc, size_t size) {
 
-static size_t GC_Ideal_Size(size_t size) {
-  size = (size_t)((double)(size+1) / GC_Load_Factor);
-  for (size_t i = 0; i < GC_PRIMES_COUNT; i++) {
-    if (GC_Primes[i] >= size) { return GC_Primes[i]; }
+  free(gc->index);
+  gc->nindex = size;
+  gc->index = calloc(gc->nindex, sizeof(struct GCPage*));
+
+#if CELLO_MEMORY_CHECK == 1
+  if (gc->index is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate GC Page Index, out of memory!");
   }
-  size_t last = GC_Primes[GC_PRIMES_COUNT-1];
-  for (size_t i = 0;; i++) {
-    if (last * i >= size) { return last * i; }
+#endif
+
+  for (size_t i = 0; i < gc->npages; i++) {
+    GC_Index_Put(gc, gc->pages[i]);
   }
 }
 
-static void GC_Set_Ptr(struct GC* gc, var ptr, bool root);
+static void GC_Index_Rem(struct GC* gc, struct GCPage* p) {
 
-static void GC_Rehash(struct GC* gc, size_t new_size) {
+  size_t mask = gc->nindex - 1;
+  size_t i = hash_mix(p->page) & mask;
+  while (gc->index[i] isnt p) { i = (i+1) & mask; }
+
+  /* Shift back any following pages which could have used the gap */
+  size_t j = i;
+  while (true) {
+    gc->index[i] = NULL;
+    while (true) {
+      j = (j+1) & mask;
+      if (gc->index[j] is NULL) { return; }
+      size_t k = hash_mix(gc->index[j]->page) & mask;
+      if (i <= j ? (i < k and k <= j) : (i < k or k <= j)) { continue; }
+      break;
+    }
+    gc->index[i] = gc->index[j];
+    i = j;
+  }
+
+}
+
+static struct GCPage* GC_Page_New(struct GC* gc, uintptr_t page) {
+
+  struct GCPage* p = calloc(1, sizeof(struct GCPage));
 
-  struct GCEntry* old_entries = gc->entries;
-  size_t old_size = gc->nslots;
-  
-  gc->nslots = new_size;
-  gc->entries = calloc(gc->nslots, sizeof(struct GCEntry));
-  
 #if CELLO_MEMORY_CHECK == 1
-  if (gc->entries is NULL) {
-    throw(OutOfMemoryError, "Cannot allocate GC Pointer Table, out of memory!");
-    return;
+  if (p is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate GC Page, out of memory!");
   }
 #endif
-  
-  for (size_t i = 0; i < old_size; i++) {
-    if (old_entries[i].hash isnt 0) {
-      GC_Set_Ptr(gc, old_entries[i].ptr, old_entries[i].root);
+
+  p->page = page;
+  p->index = gc->npages;
+
+  if (gc->npages is gc->mpages) {
+    gc->mpages = gc->mpages is 0 ? 64 : gc->mpages * 2;
+    gc->pages = realloc(gc->pages, sizeof(struct GCPage*) * gc->mpages);
+#if CELLO_MEMORY_CHECK == 1
+    if (gc->pages is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Pages, out of memory!");
     }
+#endif
   }
-  
-  free(old_entries);
 
-}
+  gc->pages[gc->npages] = p;
+  gc->npages++;
 
-static void GC_Resize_More(struct GC* gc) {
-  size_t new_size = GC_Ideal_Size(gc->nitems);  
-  size_t old_size = gc->nslots;
-  if (new_size > old_size) { GC_Rehash(gc, new_size); }
-}
+  if (gc->npages * 2 > gc->nindex) {
+    GC_Index_Resize(gc, gc->nindex * 2);
+  } else {
+    GC_Index_Put(gc, p);
+  }
 
-static void GC_Resize_Less(struct GC* gc) {
-  size_t new_size = GC_Ideal_Size(gc->nitems);  
-  size_t old_size = gc->nslots;
-  if (new_size < old_size) { GC_Rehash(gc, new_size); }
+  return p;
 }
 
-static uint64_t GC_Hash(var ptr) {
-  return ((uintptr_t)ptr) >> 3;
-}
+static void GC_Page_Del(struct GC* gc, struct GCPage* p) {
 
-static void GC_Set_Ptr(struct GC* gc, var ptr, bool root) {
-  
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
-  uint64_t j = 0;
-  uint64_t ihash = i+1;
-  struct GCEntry entry = { ptr, ihash, root, 0 };
-  
-  while (true) {
-    
-    uint64_t h = gc->entries[i].hash;
-    if (h is 0) { gc->entries[i] = entry; return; }
-    if (gc->entries[i].ptr == entry.ptr) { return; }
-    
-    uint64_t p = GC_Probe(gc, i, h);
-    if (j >= p) {
-      struct GCEntry tmp = gc->entries[i];
-      gc->entries[i] = entry;
-      entry = tmp;
-      j = p;
-    }
-    
-    i = (i+1) % gc->nslots;
-    j++;
+  GC_Index_Rem(gc, p);
+
+  gc->npages--;
+  gc->pages[p->index] = gc->pages[gc->npages];
+  gc->pages[p->index]->index = p->index;
+  free(p->sites);
+  free(p);
+
+  if (gc->nindex > gc->mindex and gc->npages * 8 < gc->nindex) {
+    GC_Index_Resize(gc, gc->nindex / 2);
   }
-  
 }
 
-static bool GC_Mem_Ptr(struct GC* gc, var ptr) {
+static void GC_Slab_Chunk(struct GC* gc) {
 
-  if (gc->nslots is 0) { return false; }
-  
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
-  uint64_t j = 0;
-  
-  while (true) {
-    uint64_t h = gc->entries[i].hash;
-    if (h is 0 or j > GC_Probe(gc, i, h)) { return false; }
-    if (gc->entries[i].ptr == ptr) { return true; }
-    i = (i+1) % gc->nslots; j++;
+  struct GCChunk* c = malloc(sizeof(struct GCChunk));
+  char* data = malloc((GC_SLAB_PAGES + 1) * GC_PAGE_SIZE);
+
+#if CELLO_MEMORY_CHECK == 1
+  if (c is NULL or data is NULL) {
+    free(c);
+    free(data);
+    throw(OutOfMemoryError, "Cannot allocate GC Slab, out of memory!");
   }
+#endif
 
-}
+  c->data = data;
+  c->used = 0;
+  c->lent = 0;
+  c->orphan = false;
+  c->returned = NULL;
+  c->index = gc->nchunks;
 
-static void GC_Rem_Ptr(struct GC* gc, var ptr) {
-  
-  if (gc->nslots is 0) { return; }
-  
-  for (size_t i = 0; i < gc->freenum; i++) {
-    if (gc->freelist[i] is ptr) { gc->freelist[i] = NULL; }
+  if (gc->nchunks is gc->mchunks) {
+    gc->mchunks = gc->mchunks is 0 ? 16 : gc->mchunks * 2;
+    gc->chunks = realloc(gc->chunks, sizeof(struct GCChunk*) * gc->mchunks);
   }
-  
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
-  uint64_t j = 0;
-  
-  while (true) {
-    
-    uint64_t h = gc->entries[i].hash;
-    if (h is 0 or j > GC_Probe(gc, i, h)) { return; }
-    if (gc->entries[i].ptr is ptr) {
-      
-      var freeitem = gc->entries[i].ptr;
-      memset(&gc->entries[i], 0, sizeof(struct GCEntry));
-      
-      j = i;
-      while (true) { 
-        uint64_t nj = (j+1) % gc->nslots;
-        uint64_t nh = gc->entries[nj].hash;
-        if (nh isnt 0 and GC_Probe(gc, nj, nh) > 0) {
-          memcpy(&gc->entries[j], &gc->entries[nj], sizeof(struct GCEntry));
-          memset(&gc->entries[nj], 0, sizeof(struct GCEntry));
-          j = nj;
-        } else {
-          break;
-        }  
-      }
-      
-      gc->nitems--;
-      
-      dealloc(destruct(freeitem));
-      return;
-    }
-    
-    i = (i+1) % gc->nslots; j++;
+
+  /* Room for every page of every chunk to become spare again */
+  if ((gc->nchunks + 1) * GC_SLAB_PAGES > gc->mspare) {
+    gc->mspare = gc->mchunks * GC_SLAB_PAGES;
+    gc->spare = realloc(gc->spare, sizeof(struct GCSpare) * gc->mspare);
   }
-  
+
+#if CELLO_MEMORY_CHECK == 1
+  if (gc->chunks is NULL or gc->spare is NULL) {
+    throw(OutOfMemoryError, "Cannot grow GC Slab, out of memory!");
+  }
+#endif
+
+  gc->chunks[gc->nchunks++] = c;
+
+  /* Pages are handed out lowest address first */
+  uintptr_t first = ((uintptr_t)data + GC_PAGE_SIZE - 1) >> GC_PAGE_SHIFT;
+  for (size_t i = GC_SLAB_PAGES; i-- > 0;) {
+    gc->spare[gc->nspare].page = first + i;
+    gc->spare[gc->nspare].chunk = c;
+    gc->nspare++;
+  }
+
 }
 
-static void GC_Mark_Item(void* _gc, void* ptr);
-static void GC_Recurse(struct GC* gc, var ptr);
+static struct GCPage* GC_Slab_Page(struct GC* gc, size_t cls) {
 
-static void GC_Mark_And_Recurse(void* _gc, void* ptr) {
-  struct GC* gc = _gc;
-  GC_Mark_Item(gc, ptr);
-  GC_Recurse(gc, ptr);
+  if (gc->nspare is 0) { GC_Slab_Chunk(gc); }
+
+  struct GCSpare spare = gc->spare[--gc->nspare];
+  struct GCPage* p = GC_Page(gc, spare.page);
+  if (p is NULL) { p = GC_Page_New(gc, spare.page); }
+  p->slab = (cls + 1) * GC_SLAB_ALIGN;
+  p->chunk = spare.chunk;
+  p->chunk->used++;
+
+  char* base = (char*)(spare.page << GC_PAGE_SHIFT);
+  for (size_t i = GC_PAGE_SIZE / p->slab; i-- > 0;) {
+    var slot = base + i * p->slab;
+    *(var*)slot = p->free;
+    p->free = slot;
+  }
+
+  p->listed = true;
+  p->next = gc->slabs[cls];
+  gc->slabs[cls] = p;
+  return p;
 }
 
-static void GC_Recurse(struct GC* gc, var ptr) {
-  
-  var type = type_of(ptr);
-  
-  if (type is Int    or  type is Float   
-  or  type is String or  type is Type
-  or  type is File   or  type is Process
-  or  type is Function) { return; }
-    
-  struct Mark* m = type_instance(type, Mark);
-  if (m and m->mark) {
-    m->mark(ptr, gc, (void(*)(var,void*))GC_Mark_And_Recurse);
-    return;
+static void GC_Slab_Free(struct GC* gc, struct GCPage* p, var ptr) {
+
+  var slot = header(ptr);
+  *(var*)slot = p->free;
+  p->free = slot;
+  p->used--;
+
+  if (not p->listed) {
+    size_t cls = p->slab / GC_SLAB_ALIGN - 1;
+    p->listed = true;
+    p->next = gc->slabs[cls];
+    gc->slabs[cls] = p;
+  }
+}
+
+/*
+**  Objects handed to another thread keep their slab slot, which
+**  is counted as lent by its chunk. When the adopting collector
+**  frees one the slot is pushed onto the chunk's `returned` list
+**  for the owner to put back on its page. If the owner has exited
+**  in the meantime the chunk is orphaned instead, and is freed by
+**  whichever thread returns the last lent slot.
+*/
+
+#if defined(CELLO_UNIX)
+static pthread_mutex_t GC_Remote_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static void GC_Remote_Lock(void) { pthread_mutex_lock(&GC_Remote_Mutex); }
+static void GC_Remote_Unlock(void) { pthread_mutex_unlock(&GC_Remote_Mutex); }
+#elif defined(CELLO_WINDOWS)
+static SRWLOCK GC_Remote_Mutex = SRWLOCK_INIT;
+static void GC_Remote_Lock(void) { AcquireSRWLockExclusive(&GC_Remote_Mutex); }
+static void GC_Remote_Unlock(void) { ReleaseSRWLockExclusive(&GC_Remote_Mutex); }
+#else
+static void GC_Remote_Lock(void) {}
+static void GC_Remote_Unlock(void) {}
+#endif
+
+static struct GCBatch* GC_Batches[GC_BATCHES];
+
+static void GC_Remote_Free(struct GCChunk* c, var ptr) {
+
+  var slot = header(ptr);
+  bool orphaned = false;
+
+  GC_Remote_Lock();
+  c->lent--;
+  if (c->orphan) {
+    orphaned = c->lent is 0;
+  } else {
+    *(var*)slot = c->returned;
+    c->returned = slot;
   }
-    
-  for (size_t i = 0; i+sizeof(var) <= size(type); i += sizeof(var)) {
-    var p = ((char*)ptr) + i;
-    GC_Mark_Item(gc, *((var*)p));
+  GC_Remote_Unlock();
+
+  if (orphaned) {
+    free(c->data);
+    free(c);
   }
-  
 }
 
-static void GC_Print(struct GC* gc);
+static void GC_Remote_Reclaim(struct GC* gc) {
 
-static void GC_Mark_Item(void* _gc, void* ptr) {
-  struct GC* gc = _gc;
-  uintptr_t pval = (uintptr_t)ptr;
-  if (pval % sizeof(var) isnt 0
-  or  pval < gc->minptr
-  or  pval > gc->maxptr) { return; }
-  
-  uint64_t i = GC_Hash(ptr) % gc->nslots;
-  uint64_t j = 0;
-  
-  while (true) {
-    
-    uint64_t h = gc->entries[i].hash;
-    
-    if (h is 0 or j > GC_Probe(gc, i, h)) { return; }
-    
-    if (gc->entries[i].ptr is ptr and not gc->entries[i].marked) {
-      gc->entries[i].marked = true;
-      GC_Recurse(gc, gc->entries[i].ptr);
-      return;
+  if (gc->lent is 0) { return; }
+
+  for (size_t i = 0; i < gc->nchunks; i++) {
+
+    struct GCChunk* c = gc->chunks[i];
+
+    GC_Remote_Lock();
+    var slot = c->returned;
+    c->returned = NULL;
+    GC_Remote_Unlock();
+
+    while (slot isnt NULL) {
+      var next = *(var*)slot;
+      struct GCPage* p = GC_Page(gc, (uintptr_t)slot >> GC_PAGE_SHIFT);
+      GC_Slab_Free(gc, p, (char*)slot + sizeof(struct Header));
+      gc->lent--;
+      slot = next;
     }
-    
-    i = (i+1) % gc->nslots; j++;
   }
-  
+
 }
 
-static void CELLO_NASAN GC_Mark_Stack(struct GC* gc) {
-  
-  var stk = NULL;
-  var bot = gc->bottom;
-  var top = &stk;
-  
-  if (bot == top) { return; }
-  
-  if (bot < top) {
-    for (var p = top; p >= bot; p = ((char*)p) - sizeof(var)) {
-      GC_Mark_Item(gc, *((var*)p));
+static void GC_Slab_Reclaim(struct GC* gc) {
+
+  GC_Remote_Reclaim(gc);
+
+  /* Empty pages go back to their chunk */
+  for (size_t i = 0; i < GC_SLAB_CLASSES; i++) {
+    struct GCPage** link = &gc->slabs[i];
+    while (*link isnt NULL) {
+      struct GCPage* p = *link;
+      if (p->used isnt 0) { link = &p->next; continue; }
+      *link = p->next;
+      gc->spare[gc->nspare].page = p->page;
+      gc->spare[gc->nspare].chunk = p->chunk;
+      gc->nspare++;
+      p->chunk->used--;
+      GC_Page_Del(gc, p);
     }
   }
-  
-  if (bot > top) {
-    for (var p = top; p <= bot; p = ((char*)p) + sizeof(var)) {
-      GC_Mark_Item(gc, *((var*)p));
-    }
+
+  /* And chunks with no pages in use are freed */
+  size_t j = 0;
+  for (size_t i = 0; i < gc->nspare; i++) {
+    if (gc->spare[i].chunk->used is 0) { continue; }
+    gc->spare[j++] = gc->spare[i];
   }
-  
-}
+  gc->nspare = j;
 
-static void GC_Mark_Stack_Fake(struct GC* gc) { }
+  for (size_t i = gc->nchunks; i-- > 0;) {
+    struct GCChunk* c = gc->chunks[i];
+    if (c->used isnt 0) { continue; }
+    gc->nchunks--;
+    gc->chunks[i] = gc->chunks[gc->nchunks];
+    gc->chunks[i]->index = i;
+    free(c->data);
+    free(c);
+  }
+
+}
+
+var gc_alloc(var self, size_t size) {
+
+  struct GC* gc = self;
+  if (not gc->running
+  or  not gc->slab
+  or  size > GC_SLAB_MAX) { return NULL; }
+
+  size_t cls = (size - 1) / GC_SLAB_ALIGN;
+  struct GCPage* p = gc->slabs[cls];
+  if (p is NULL) { p = GC_Slab_Page(gc, cls); }
+
+  var slot = p->free;
+  p->free = *(var*)slot;
+  p->used++;
+
+  if (p->free is NULL) {
+    gc->slabs[cls] = p->next;
+    p->listed = false;
+  }
+
+  memset(slot, 0, p->slab);
+  return slot;
+}
+
+static bool GC_Set_Ptr(struct GC* gc, var ptr, bool root) {
+
+  uintptr_t page = (uintptr_t)ptr >> GC_PAGE_SHIFT;
+  struct GCPage* p = GC_Page(gc, page);
+  if (p is NULL) { p = GC_Page_New(gc, page); }
+
+  size_t i = GC_Slot(ptr);
+  if (GC_Bit(p->objects, i)) { return false; }
+
+  /*
+  **  While a collection is in progress new objects are
+  **  allocated black, meaning they are marked for the
+  **  current cycle and will not be swept by it.
+  */
+
+  GC_Bit_Set(p->objects, i);
+  GC_Bit_Put(p->marks, i, gc->phase isnt GC_IDLE);
+  GC_Bit_Put(p->roots, i, root);
+  GC_Bit_Put(p->old, i, not gc->generational);
+  GC_Bit_Clear(p->dirty, i);
+  if (p->sites isnt NULL) { p->sites[i] = NULL; }
+  p->count++;
+  gc->nitems++;
+  return true;
+}
+
+static struct GCPage* GC_Lookup_Page(struct GC* gc, var ptr) {
+  uintptr_t pval = (uintptr_t)ptr;
+  if (pval % sizeof(var) isnt 0
+  or  pval < gc->minptr
+  or  pval > gc->maxptr) { return NULL; }
+  return GC_Page(gc, pval >> GC_PAGE_SHIFT);
+}
+
+static struct GCPage* GC_Lookup(struct GC* gc, var ptr) {
+  struct GCPage* p = GC_Lookup_Page(gc, ptr);
+  if (p is NULL or not GC_Bit(p->objects, GC_Slot(ptr))) { return NULL; }
+  return p;
+}
+
+static bool GC_Mem_Ptr(struct GC* gc, var ptr) {
+  return GC_Lookup(gc, ptr) isnt NULL;
+}
+
+static void GC_Page_Release(struct GC* gc, struct GCPage* p) {
+  p->count--;
+  if (p->count is 0 and p->slab is 0) { GC_Page_Del(gc, p); }
+}
+
+static size_t GC_Size(var ptr) {
+  return sizeof(struct Header) + size(type_of(ptr));
+}
+
+static void GC_Del_Ptr(struct GC* gc, struct GCPage* p, size_t i) {
+  GC_Bit_Clear(p->objects, i);
+  GC_Bit_Clear(p->marks, i);
+  GC_Bit_Clear(p->roots, i);
+  GC_Bit_Clear(p->dirty, i);
+  gc->nitems--;
+  gc->bytes -= GC_Size(GC_Slot_Ptr(p, i));
+}
+
+static void GC_Freed(struct GC* gc, var ptr) {
+  gc->stats.objects_freed++;
+  gc->stats.bytes_freed += GC_Size(ptr);
+}
+
+static void GC_Rem_Ptr(struct GC* gc, var ptr) {
+
+  struct GCPage* p = GC_Lookup_Page(gc, ptr);
+  if (p is NULL) { return; }
+  size_t i = GC_Slot(ptr);
+
+  if (GC_Bit(p->objects, i)) {
+    GC_Del_Ptr(gc, p, i);
+  } else if (GC_Bit(p->dying, i)) {
+    GC_Bit_Clear(p->dying, i);
+  } else {
+    return;
+  }
+
+  /* Objects which are dead but not yet destructed go right away */
+  GC_Freed(gc, ptr);
+  bool slab = p->slab isnt 0;
+  struct GCChunk* remote = p->remote;
+  GC_Page_Release(gc, p);
+  if (remote) {
+    GC_Remote_Free(remote, destruct(ptr));
+  } else if (slab) {
+    GC_Slab_Free(gc, p, destruct(ptr));
+  } else {
+    dealloc(destruct(ptr));
+  }
+}
+
+static var* GC_Push(var* items, size_t* num, size_t* max, var ptr) {
+  if (*num is *max) {
+    *max = *max is 0 ? 64 : *max * 2;
+    items = realloc(items, sizeof(var) * (*max));
+#if CELLO_MEMORY_CHECK == 1
+    if (items is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC list, out of memory!");
+    }
+#endif
+  }
+  items[*num] = ptr;
+  (*num)++;
+  return items;
+}
+
+static void GC_Flip(struct GC* gc) {
+  for (size_t i = 0; i < gc->npages; i++) {
+    memset(gc->pages[i]->marks, 0, sizeof(gc->pages[i]->marks));
+  }
+}
+
+static void GC_Flip_Young(struct GC* gc) {
+
+  /* A nursery collection only inspects the marks of young objects */
+  for (size_t i = 0; i < gc->nyoung; i++) {
+    struct GCPage* p = GC_Lookup(gc, gc->young[i]);
+    if (p isnt NULL) { GC_Bit_Clear(p->marks, GC_Slot(gc->young[i])); }
+  }
+
+}
+
+static void GC_Recurse(struct GC* gc, var ptr);
+
+static void GC_Trace(void* ctx, var ptr,
+  void(*item)(void*,void*), void(*inner)(void*,void*),
+  void(*found)(void*,void*));
+
+static void GC_Mark_Ptr(struct GC* gc, struct GCPage* p, var ptr) {
+
+  size_t i = GC_Slot(ptr);
+  if (GC_Bit(p->marks, i)) { return; }
+
+  /* Old objects are assumed live during a nursery collection */
+  if (gc->minor and GC_Bit(p->old, i)) { return; }
+
+  GC_Bit_Set(p->marks, i);
+  gc->gray = GC_Push(gc->gray, &gc->ngray, &gc->mgray, ptr);
+}
+
+/*
+**  Marked objects are pushed onto the `gray` stack rather than
+**  being traced recursively, so marking deep structures such as
+**  long lists uses no C stack. Popped objects first pass through
+**  a small queue where they are prefetched, so their memory has
+**  usually arrived by the time they are scanned.
+*/
+
+static var GC_Pop(struct GC* gc) {
+
+  while (gc->nfetch < GC_PREFETCH and gc->ngray > 0) {
+    gc->ngray--;
+    var ptr = gc->gray[gc->ngray];
+    CELLO_PREFETCH(ptr);
+    gc->fetch[(gc->fetchhead + gc->nfetch) % GC_PREFETCH] = ptr;
+    gc->nfetch++;
+  }
+
+  if (gc->nfetch is 0) { return NULL; }
+
+  var ptr = gc->fetch[gc->fetchhead];
+  gc->fetchhead = (gc->fetchhead + 1) % GC_PREFETCH;
+  gc->nfetch--;
+  return ptr;
+}
+
+static bool GC_Gray(struct GC* gc) {
+  return gc->ngray > 0 or gc->nfetch > 0;
+}
+
+static void GC_Scan(struct GC* gc) {
+
+  var ptr = GC_Pop(gc);
+
+  /* Between incremental slices gray objects may be deleted */
+  if (gc->phase is GC_MARKING and GC_Lookup(gc, ptr) is NULL) { return; }
+
+  GC_Recurse(gc, ptr);
+}
+
+static void GC_Mark_Item(void* _gc, void* ptr) {
+  struct GC* gc = _gc;
+  struct GCPage* p = GC_Lookup(gc, ptr);
+  if (p isnt NULL) { GC_Mark_Ptr(gc, p, ptr); }
+}
+
+static void GC_Weak_Found(void* _gc, void* ptr) {
+  struct GC* gc = _gc;
+  (void)ptr;
+  if (gc->scanning is NULL) { return; }
+  gc->weak = GC_Push(gc->weak, &gc->nweak, &gc->mweak, gc->scanning);
+}
+
+static void GC_Mark_And_Recurse(void* _gc, void* ptr) {
+  struct GC* gc = _gc;
+
+  if (ptr is NULL) { return; }
+
+  /*
+  **  Registered objects are traced when they are first marked,
+  **  everything else is data stored inside of another object
+  **  and must be traced straight away.
+  */
+
+  struct GCPage* p = GC_Lookup(gc, ptr);
+  if (p isnt NULL) {
+    GC_Mark_Ptr(gc, p, ptr);
+  } else {
+    GC_Trace(gc, ptr, GC_Mark_Item, GC_Mark_And_Recurse, GC_Weak_Found);
+  }
+}
+
+/*
+**  Weak references and collections keyed on them are not traced
+**  and are instead passed to `found`, which notes the collected
+**  object currently being scanned so it can be revisited once
+**  marking is complete.
+*/
+
+static bool GC_Ephemeron(var type, var ptr) {
+  struct Get* g = type_instance(type, Get);
+  return g and g->key_type and g->key_type(ptr) is Weak;
+}
+
+static void GC_Trace(void* ctx, var ptr,
+  void(*item)(void*,void*), void(*inner)(void*,void*),
+  void(*found)(void*,void*)) {
+
+  var type = type_of(ptr);
+
+  if (type is Weak) {
+    found(ctx, ptr);
+    return;
+  }
+
+  struct Mark* m = type_instance(type, Mark);
+  if (m and m->mark) {
+    if (GC_Ephemeron(type, ptr)) {
+      found(ctx, ptr);
+      return;
+    }
+    m->mark(ptr, ctx, (void(*)(var,void*))inner);
+    return;
+  }
+
+  size_t words = size(type) / sizeof(var);
+
+  struct Layout* l = type_instance(type, Layout);
+  if (l and l->layout) {
+    uint64_t bits = l->layout();
+    for (size_t i = 0; i < words and bits isnt 0; i++) {
+      if (bits & 1) { item(ctx, ((var*)ptr)[i]); }
+      if (i < 63) { bits >>= 1; }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < words; i++) {
+    item(ctx, ((var*)ptr)[i]);
+  }
+
+}
+
+static void GC_Recurse(struct GC* gc, var ptr) {
+  gc->scanning = ptr;
+  GC_Trace(gc, ptr, GC_Mark_Item, GC_Mark_And_Recurse, GC_Weak_Found);
+  gc->scanning = NULL;
+}
+
+#ifdef GC_PARALLEL
+
+/*
+**  Parallel marking splits the gray stack between a pool of
+**  helper threads owned by the collector. Each worker keeps its
+**  own deque, popping from the top and, once empty, stealing
+**  half of the oldest items from another worker. Mark bits are
+**  set with an atomic fetch-or so each object is scanned by
+**  exactly one worker. Pages and their other bitmaps are not
+**  modified while marking so lookups need no locking.
+**
+**  Marking ends when every worker is idle, which can only happen
+**  once every deque is empty since workers only push to their
+**  own deque while busy.
+*/
+
+static void GC_Par_Push(struct GCWorker* w, var ptr) {
+  pthread_mutex_lock(&w->lock);
+  w->items = GC_Push(w->items, &w->nitems, &w->mitems, ptr);
+  pthread_mutex_unlock(&w->lock);
+}
+
+static var GC_Par_Pop(struct GCWorker* w) {
+  var ptr = NULL;
+  pthread_mutex_lock(&w->lock);
+  if (w->nitems > w->head) {
+    w->nitems--;
+    ptr = w->items[w->nitems];
+    CELLO_PREFETCH(w->nitems > w->head ? w->items[w->nitems-1] : NULL);
+  }
+  if (w->nitems is w->head) {
+    w->nitems = 0;
+    w->head = 0;
+  }
+  pthread_mutex_unlock(&w->lock);
+  return ptr;
+}
+
+static size_t GC_Par_Size(struct GCWorker* w) {
+  return __atomic_load_n(&w->nitems, __ATOMIC_RELAXED)
+       - __atomic_load_n(&w->head, __ATOMIC_RELAXED);
+}
+
+static bool GC_Par_Steal(struct GCWorker* w) {
+  struct GC* gc = w->gc;
+  size_t self = w - gc->workers;
+
+  for (size_t i = 1; i < gc->nthreads; i++) {
+
+    struct GCWorker* v = &gc->workers[(self + i) % gc->nthreads];
+    if (GC_Par_Size(v) is 0) { continue; }
+
+    var stolen[GC_STEAL];
+    size_t nstolen = 0;
+
+    pthread_mutex_lock(&v->lock);
+    size_t avail = v->nitems - v->head;
+    nstolen = (avail + 1) / 2 < GC_STEAL ? (avail + 1) / 2 : GC_STEAL;
+    if (avail is 0) { nstolen = 0; }
+    memcpy(stolen, v->items + v->head, sizeof(var) * nstolen);
+    v->head += nstolen;
+    if (v->nitems is v->head) {
+      v->nitems = 0;
+      v->head = 0;
+    }
+    pthread_mutex_unlock(&v->lock);
+
+    if (nstolen is 0) { continue; }
+
+    pthread_mutex_lock(&w->lock);
+    for (size_t j = 0; j < nstolen; j++) {
+      w->items = GC_Push(w->items, &w->nitems, &w->mitems, stolen[j]);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return true;
+  }
+
+  return false;
+}
+
+static bool GC_Par_Work(struct GC* gc) {
+  for (size_t i = 0; i < gc->nthreads; i++) {
+    if (GC_Par_Size(&gc->workers[i]) isnt 0) { return true; }
+  }
+  return false;
+}
+
+static void GC_Par_Mark_Ptr(struct GCWorker* w, struct GCPage* p, var ptr) {
+  struct GC* gc = w->gc;
+
+  size_t i = GC_Slot(ptr);
+  uint64_t bit = (uint64_t)1 << (i % 64);
+  uint64_t* word = &p->marks[i / 64];
+
+  if (__atomic_load_n(word, __ATOMIC_RELAXED) & bit) { return; }
+  if (gc->minor and GC_Bit(p->old, i)) { return; }
+
+  if (not (__atomic_fetch_or(word, bit, __ATOMIC_RELAXED) & bit)) {
+    GC_Par_Push(w, ptr);
+  }
+}
+
+static void GC_Par_Mark_Item(void* _w, void* ptr) {
+  struct GCWorker* w = _w;
+  struct GCPage* p = GC_Lookup(w->gc, ptr);
+  if (p isnt NULL) { GC_Par_Mark_Ptr(w, p, ptr); }
+}
+
+static void GC_Par_Weak_Found(void* _w, void* ptr) {
+  struct GCWorker* w = _w;
+  (void)ptr;
+  if (w->scanning is NULL) { return; }
+  w->weak = GC_Push(w->weak, &w->nweak, &w->mweak, w->scanning);
+}
+
+static void GC_Par_Mark_And_Recurse(void* _w, void* ptr) {
+  struct GCWorker* w = _w;
+  if (ptr is NULL) { return; }
+  struct GCPage* p = GC_Lookup(w->gc, ptr);
+  if (p isnt NULL) {
+    GC_Par_Mark_Ptr(w, p, ptr);
+  } else {
+    GC_Trace(w, ptr,
+      GC_Par_Mark_Item, GC_Par_Mark_And_Recurse, GC_Par_Weak_Found);
+  }
+}
+
+static void GC_Par_Drain(struct GCWorker* w) {
+  struct GC* gc = w->gc;
+
+  while (true) {
+
+    var ptr = GC_Par_Pop(w);
+    if (ptr isnt NULL) {
+      w->scanning = ptr;
+      GC_Trace(w, ptr,
+        GC_Par_Mark_Item, GC_Par_Mark_And_Recurse, GC_Par_Weak_Found);
+      w->scanning = NULL;
+      continue;
+    }
+
+    if (GC_Par_Steal(w)) { continue; }
+
+    __atomic_add_fetch(&gc->nidle, 1, __ATOMIC_SEQ_CST);
+
+    while (true) {
+      if (__atomic_load_n(&gc->nidle, __ATOMIC_SEQ_CST) is gc->nthreads) {
+        return;
+      }
+      if (GC_Par_Work(gc)) {
+        __atomic_sub_fetch(&gc->nidle, 1, __ATOMIC_SEQ_CST);
+        break;
+      }
+      sched_yield();
+    }
+  }
+
+}
+
+static void* GC_Par_Run(void* arg) {
+  struct GCWorker* w = arg;
+  struct GC* gc = w->gc;
+
+  pthread_mutex_lock(&gc->pool_lock);
+
+  while (true) {
+
+    while (gc->round is w->round and not gc->shutdown) {
+      pthread_cond_wait(&gc->pool_wake, &gc->pool_lock);
+    }
+
+    if (gc->shutdown) { break; }
+    w->round = gc->round;
+
+    pthread_mutex_unlock(&gc->pool_lock);
+    GC_Par_Drain(w);
+    pthread_mutex_lock(&gc->pool_lock);
+
+    gc->nbusy--;
+    if (gc->nbusy is 0) { pthread_cond_signal(&gc->pool_done); }
+  }
+
+  pthread_mutex_unlock(&gc->pool_lock);
+  return NULL;
+}
+
+static void GC_Par_Mark(struct GC* gc) {
+
+  for (size_t i = 0; GC_Gray(gc); i++) {
+    struct GCWorker* w = &gc->workers[i % gc->nthreads];
+    w->items = GC_Push(w->items, &w->nitems, &w->mitems, GC_Pop(gc));
+  }
+
+  gc->nidle = 0;
+
+  pthread_mutex_lock(&gc->pool_lock);
+  gc->round++;
+  gc->nbusy = gc->nthreads - 1;
+  pthread_cond_broadcast(&gc->pool_wake);
+  pthread_mutex_unlock(&gc->pool_lock);
+
+  GC_Par_Drain(&gc->workers[0]);
+
+  pthread_mutex_lock(&gc->pool_lock);
+  while (gc->nbusy > 0) {
+    pthread_cond_wait(&gc->pool_done, &gc->pool_lock);
+  }
+  pthread_mutex_unlock(&gc->pool_lock);
+
+  for (size_t i = 0; i < gc->nthreads; i++) {
+    struct GCWorker* w = &gc->workers[i];
+    for (size_t j = 0; j < w->nweak; j++) {
+      gc->weak = GC_Push(gc->weak, &gc->nweak, &gc->mweak, w->weak[j]);
+    }
+    w->nweak = 0;
+  }
+
+}
+
+static void GC_Par_Stop(struct GC* gc) {
+
+  if (gc->workers is NULL) { return; }
+
+  pthread_mutex_lock(&gc->pool_lock);
+  gc->shutdown = true;
+  pthread_cond_broadcast(&gc->pool_wake);
+  pthread_mutex_unlock(&gc->pool_lock);
+
+  for (size_t i = 0; i < gc->nthreads; i++) {
+    if (i isnt 0) { pthread_join(gc->workers[i].thread, NULL); }
+    pthread_mutex_destroy(&gc->workers[i].lock);
+    free(gc->workers[i].items);
+    free(gc->workers[i].weak);
+  }
+
+  pthread_cond_destroy(&gc->pool_done);
+  pthread_cond_destroy(&gc->pool_wake);
+  pthread_mutex_destroy(&gc->pool_lock);
+
+  free(gc->workers);
+  gc->workers = NULL;
+  gc->nthreads = 1;
+}
+
+static void GC_Par_Start(struct GC* gc, size_t nthreads) {
+
+  gc->workers = calloc(nthreads, sizeof(struct GCWorker));
+
+#if CELLO_MEMORY_CHECK == 1
+  if (gc->workers is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate GC Workers, out of memory!");
+  }
+#endif
+
+  gc->nthreads = nthreads;
+  gc->shutdown = false;
+  gc->round = 0;
+  gc->nbusy = 0;
+  pthread_mutex_init(&gc->pool_lock, NULL);
+  pthread_cond_init(&gc->pool_wake, NULL);
+  pthread_cond_init(&gc->pool_done, NULL);
+
+  for (size_t i = 0; i < nthreads; i++) {
+    gc->workers[i].gc = gc;
+    pthread_mutex_init(&gc->workers[i].lock, NULL);
+  }
+
+  for (size_t i = 1; i < nthreads; i++) {
+    int err = pthread_create(&gc->workers[i].thread, NULL,
+      GC_Par_Run, &gc->workers[i]);
+    if (err isnt 0) {
+      gc->nthreads = i;
+      GC_Par_Stop(gc);
+      throw(ValueError, "Unable to Create GC Worker Thread");
+    }
+  }
+
+}
+
+#endif
+
+static void GC_Drain(struct GC* gc) {
+
+#ifdef GC_PARALLEL
+  if (gc->nthreads > 1 and gc->phase isnt GC_MARKING
+  and gc->nitems >= GC_PARALLEL_MIN) {
+    GC_Par_Mark(gc);
+    return;
+  }
+#endif
+
+  while (GC_Gray(gc)) { GC_Scan(gc); }
+}
+
+static void GC_Print(struct GC* gc);
+
+static void CELLO_NASAN GC_Mark_Stack(struct GC* gc) {
+
+  var stk = NULL;
+  var bot = gc->bottom;
+  var top = &stk;
+
+  if (bot == top) { return; }
+
+  gc->stats.stack_size = bot < top
+    ? (size_t)((char*)top - (char*)bot)
+    : (size_t)((char*)bot - (char*)top);
+
+  if (bot < top) {
+    for (var p = top; p >= bot; p = ((char*)p) - sizeof(var)) {
+      GC_Mark_Item(gc, *((var*)p));
+    }
+  }
+
+  if (bot > top) {
+    for (var p = top; p <= bot; p = ((char*)p) + sizeof(var)) {
+      GC_Mark_Item(gc, *((var*)p));
+    }
+  }
+
+}
+
+static void GC_Mark_Stack_Fake(struct GC* gc) { }
+
+static void GC_Mark_Roots(struct GC* gc) {
+
+  /* Only young roots need visiting, old ones are in the remembered set */
+  if (gc->minor) {
+    for (size_t i = 0; i < gc->nyoung; i++) {
+      var ptr = gc->young[i];
+      struct GCPage* p = GC_Lookup(gc, ptr);
+      if (p is NULL
+      or  GC_Bit(p->old, GC_Slot(ptr))
+      or  not GC_Bit(p->roots, GC_Slot(ptr))) { continue; }
+      GC_Mark_Ptr(gc, p, ptr);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < gc->npages; i++) {
+    struct GCPage* p = gc->pages[i];
+    for (size_t j = 0; j < GC_PAGE_SLOTS; j++) {
+      if (GC_Bit(p->roots, j)) { GC_Mark_Ptr(gc, p, GC_Slot_Ptr(p, j)); }
+    }
+  }
+
+}
+
+static void GC_Mark_Remembered(struct GC* gc) {
+  for (size_t i = 0; i < gc->nremembered; i++) {
+    var ptr = gc->remembered[i];
+    struct GCPage* p = GC_Lookup(gc, ptr);
+    if (p is NULL or not GC_Bit(p->dirty, GC_Slot(ptr))) { continue; }
+    GC_Recurse(gc, ptr);
+  }
+}
+
+static void GC_Mark_Thread(struct GC* gc) {
+
+  /* Mark Thread Local Storage */
+  mark(current(Thread), gc, (void(*)(var,void*))GC_Mark_Item);
+
+  /* Mark Objects in Started Arenas, even in a nursery collection */
+  var arena = current(Arena);
+  if (arena isnt NULL) {
+    GC_Mark_Item(gc, arena);
+    GC_Recurse(gc, arena);
+  }
+
+  volatile int noinline = 1;
+
+  /* Flush Registers to Stack */
+  if (noinline) {
+    jmp_buf env;
+    memset(&env, 0, sizeof(jmp_buf));
+    setjmp(env);
+  }
+
+  /* Avoid Inlining function call */
+  void (*mark_stack)(struct GC* gc) = noinline
+    ? GC_Mark_Stack
+    : (void(*)(struct GC* gc))(NULL);
+
+  /* Mark Stack */
+  mark_stack(gc);
+
+}
+
+void GC_Mark(struct GC* gc) {
+
+  if (gc is NULL or gc->nitems is 0) { return; }
+
+  if (gc->minor) {
+    GC_Flip_Young(gc);
+  } else {
+    GC_Flip(gc);
+  }
+
+  /* Mark Roots */
+  GC_Mark_Roots(gc);
+
+  /* Mark Old Objects Written Since Last Collection */
+  if (gc->minor) { GC_Mark_Remembered(gc); }
+
+  /* Mark Thread Local Storage and Stack */
+  GC_Mark_Thread(gc);
+
+  GC_Drain(gc);
+
+}
+
+static int GC_Show(var self, var out, int pos) {
+  struct GC* gc = self;
+
+  pos = print_to(out, pos, "<'GC' At 0x%p\n", self);
+  for (size_t i = 0; i < gc->npages; i++) {
+    struct GCPage* p = gc->pages[i];
+    pos = print_to(out, pos, "| %i : Page 0x%p\n",
+      $I(i), GC_Slot_Ptr(p, 0));
+    for (size_t j = 0; j < GC_PAGE_SLOTS; j++) {
+      if (not GC_Bit(p->objects, j)) { continue; }
+      pos = print_to(out, pos, "|   %15s %p %s %s %s\n",
+        type_of(GC_Slot_Ptr(p, j)), GC_Slot_Ptr(p, j),
+        GC_Bit(p->roots, j) ? $S("root") : $S("auto"),
+        GC_Bit(p->old, j) ? $S("old") : $S("new"),
+        GC_Bit(p->marks, j) ? $S("*") : $S(" "));
+    }
+  }
+
+  return print_to(out, pos, "+------------------->\n");
+}
+
+static uint64_t GC_Now(void) {
+#if defined(CELLO_UNIX)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#elif defined(CELLO_WINDOWS)
+  LARGE_INTEGER count, freq;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&freq);
+  return (uint64_t)((double)count.QuadPart * 1e9 / freq.QuadPart);
+#else
+  return (uint64_t)((double)clock() * 1e9 / CLOCKS_PER_SEC);
+#endif
+}
+
+static void GC_Pause(struct GC* gc, uint64_t start) {
+
+  uint64_t pause = GC_Now() - start;
+  gc->stats.pauses++;
+  gc->stats.pause_total += pause;
+  if (pause > gc->stats.pause_max) { gc->stats.pause_max = pause; }
+
+  size_t bucket = 0;
+  uint64_t us = pause / 1000;
+  while (us isnt 0 and bucket < GC_HISTOGRAM - 1) { us >>= 1; bucket++; }
+  gc->stats.pause_histogram[bucket]++;
+}
+
+static void GC_Hook(struct GC* gc, bool end) {
+  if (gc->hook is NULL) { return; }
+  bool running = gc->running;
+  gc->running = false;
+  gc->hook(gc, end);
+  gc->running = running;
+}
+
+static void GC_Threshold(struct GC* gc) {
+
+  size_t items = (size_t)(gc->nitems * gc->growth) + 1;
+  gc->mitems = items > gc->min_heap ? items : gc->min_heap;
+
+  /* The byte ceiling is soft and moves up if it is exceeded by live data */
+  size_t bytes = (size_t)(gc->bytes * gc->growth) + 1;
+  gc->mbytes = gc->max_bytes is 0 ? SIZE_MAX
+    : (gc->bytes > gc->max_bytes ? bytes : gc->max_bytes);
+}
+
+/*
+**  Once marking is complete every object noted as holding weak
+**  references is visited again. First the values of ephemeron
+**  collections whose keys are alive are marked, repeating until
+**  no more objects are found. Then weak references to unmarked
+**  objects are cleared and ephemeron entries with unmarked keys
+**  are removed. Objects which hold weak references remain on the
+**  list, so an old object is revisited by nursery collections.
+*/
+
+struct GCWeak {
+  struct GC* gc;
+  bool clear;
+  bool mark;
+};
+
+static bool GC_Alive(struct GC* gc, var ptr) {
+  struct GCPage* p = GC_Lookup(gc, ptr);
+  if (p is NULL) { return true; }
+  size_t i = GC_Slot(ptr);
+  return GC_Bit(p->marks, i) or GC_Bit(p->roots, i)
+    or (gc->minor and GC_Bit(p->old, i));
+}
+
+static void GC_Weak_Process(void* _w, void* ptr);
+
+static void GC_Weak_Item(void* _w, void* ptr) {
+  struct GCWeak* w = _w;
+  if (w->mark) { GC_Mark_Item(w->gc, ptr); }
+}
+
+static void GC_Weak_Inner(void* _w, void* ptr) {
+  struct GCWeak* w = _w;
+  if (ptr is NULL) { return; }
+  if (GC_Lookup(w->gc, ptr) isnt NULL) {
+    GC_Weak_Item(w, ptr);
+  } else {
+    GC_Trace(w, ptr, GC_Weak_Item, GC_Weak_Inner, GC_Weak_Process);
+  }
+}
+
+static void GC_Weak_Remove(struct GCWeak* w, var self) {
+
+  size_t ndead = 0, mdead = 0;
+  var* dead = NULL;
+
+  for (var k = iter_init(self); k isnt Terminal; k = iter_next(self, k)) {
+    var ref = ((struct Weak*)k)->val;
+    if (not GC_Alive(w->gc, ref)) { dead = GC_Push(dead, &ndead, &mdead, ref); }
+  }
+
+  for (size_t i = 0; i < ndead; i++) { rem(self, $W(dead[i])); }
+  free(dead);
+}
+
+static void GC_Weak_Process(void* _w, void* ptr) {
+  struct GCWeak* w = _w;
+
+  if (type_of(ptr) is Weak) {
+    struct Weak* r = ptr;
+    if (w->clear and not GC_Alive(w->gc, r->val)) { r->val = NULL; }
+    return;
+  }
+
+  if (w->clear) { GC_Weak_Remove(w, ptr); }
+
+  /* Values of live keys are marked, or searched for weak references */
+  bool mark = w->mark;
+  w->mark = not w->clear;
+  for (var k = iter_init(ptr); k isnt Terminal; k = iter_next(ptr, k)) {
+    if (GC_Alive(w->gc, ((struct Weak*)k)->val)) {
+      GC_Weak_Inner(w, get(ptr, k));
+    }
+  }
+  w->mark = mark;
+}
+
+static int GC_Weak_Cmp(const void* x, const void* y) {
+  uintptr_t a = *(const uintptr_t*)x, b = *(const uintptr_t*)y;
+  return (a > b) - (a < b);
+}
+
+static void GC_Weak(struct GC* gc) {
+
+  if (gc->nweak is 0) { return; }
+
+  struct GCWeak w = { gc, false, false };
+
+  bool found = true;
+  while (found) {
+    for (size_t i = 0; i < gc->nweak; i++) {
+      var ptr = gc->weak[i];
+      if (GC_Lookup(gc, ptr) is NULL or not GC_Alive(gc, ptr)) { continue; }
+      GC_Trace(&w, ptr, GC_Weak_Item, GC_Weak_Inner, GC_Weak_Process);
+    }
+    found = GC_Gray(gc);
+    GC_Drain(gc);
+  }
+
+  /* Clear references and keep each live object on the list once */
+  qsort(gc->weak, gc->nweak, sizeof(var), GC_Weak_Cmp);
+
+  w.clear = true;
+  size_t nweak = 0;
+  for (size_t i = 0; i < gc->nweak; i++) {
+    var ptr = gc->weak[i];
+    if (nweak > 0 and gc->weak[nweak-1] is ptr) { continue; }
+    if (GC_Lookup(gc, ptr) is NULL or not GC_Alive(gc, ptr)) { continue; }
+    GC_Trace(&w, ptr, GC_Weak_Item, GC_Weak_Inner, GC_Weak_Process);
+    gc->weak[nweak++] = ptr;
+  }
+  gc->nweak = nweak;
+}
+
+/*
+**  Sweeping only identifies which objects are dead. This is a
+**  pass over the bitmaps which moves each dead object onto the
+**  `dying` list. The work of destructing and freeing them is
+**  then spread over the following allocations by `GC_Reclaim`,
+**  so destructors never run inside the collection pause.
+*/
+
+static void GC_Kill(struct GC* gc, struct GCPage* p, size_t i) {
+  GC_Del_Ptr(gc, p, i);
+  GC_Bit_Set(p->dying, i);
+  gc->dying = GC_Push(gc->dying, &gc->ndying, &gc->mdying, GC_Slot_Ptr(p, i));
+}
+
+static void GC_Sweep_Page(struct GC* gc, struct GCPage* p) {
+
+  for (size_t w = 0; w < GC_PAGE_WORDS; w++) {
+    uint64_t dead = p->objects[w] & ~(p->marks[w] | p->roots[w]);
+    for (size_t b = 0; dead isnt 0; b++, dead >>= 1) {
+      if (dead & 1) { GC_Kill(gc, p, w * 64 + b); }
+    }
+  }
+
+}
+
+void GC_Sweep(struct GC* gc) {
+
+  GC_Weak(gc);
+
+  for (size_t i = 0; i < gc->npages; i++) {
+    GC_Sweep_Page(gc, gc->pages[i]);
+  }
+
+  /* Everything surviving a full collection is promoted */
+  for (size_t i = 0; i < gc->npages; i++) {
+    struct GCPage* p = gc->pages[i];
+    memcpy(p->old, p->objects, sizeof(p->old));
+    memset(p->dirty, 0, sizeof(p->dirty));
+  }
+
+  gc->nyoung = 0;
+  gc->nremembered = 0;
+
+  GC_Threshold(gc);
+  gc->phase = GC_SWEEPING;
+
+  GC_Hook(gc, true);
+
+}
+
+static void GC_Sweep_Young(struct GC* gc) {
+
+  GC_Weak(gc);
+
+  /*
+  **  The young list may contain pointers which have since been
+  **  deleted manually, or even reused by a later allocation, so
+  **  each one is looked up again and skipped if it no longer
+  **  refers to a young object.
+  */
+
+  for (size_t i = 0; i < gc->nyoung; i++) {
+    var ptr = gc->young[i];
+    struct GCPage* p = GC_Lookup(gc, ptr);
+    size_t j = GC_Slot(ptr);
+    if (p is NULL or GC_Bit(p->old, j)) { continue; }
+    if (GC_Bit(p->marks, j) or GC_Bit(p->roots, j)) {
+      GC_Bit_Set(p->old, j);
+      continue;
+    }
+    GC_Kill(gc, p, j);
+  }
+
+  for (size_t i = 0; i < gc->nremembered; i++) {
+    var ptr = gc->remembered[i];
+    struct GCPage* p = GC_Lookup(gc, ptr);
+    if (p isnt NULL) { GC_Bit_Clear(p->dirty, GC_Slot(ptr)); }
+  }
+
+  gc->nyoung = 0;
+  gc->nremembered = 0;
+  gc->phase = GC_SWEEPING;
+
+  GC_Hook(gc, true);
+
+}
+
+/*
+**  When the background sweeper is running, objects whose type
+**  implements `Finalize` skip destruction on the owning thread
+**  and are handed to the sweeper thread in batches once their
+**  bookkeeping has been cleared. The sweeper never dispatches on
+**  them, it only calls `finalize` and then releases the memory
+**  with `free`, or hands slab slots back to the owning thread.
+*/
+
+static bool GC_Deferred(struct GC* gc, var ptr) {
+#ifdef GC_SWEEPER
+  if (not gc->sweeper) { return false; }
+  struct GCPage* p = GC_Page(gc, (uintptr_t)ptr >> GC_PAGE_SHIFT);
+  if (p isnt NULL and p->remote isnt NULL) { return false; }
+  var type = type_of(ptr);
+  struct Alloc* a = type_instance(type, Alloc);
+  if (a and a->dealloc) { return false; }
+  return type_implements(type, Finalize);
+#else
+  return false;
+#endif
+}
+
+#ifdef GC_SWEEPER
+
+static void* GC_Sweeper_Run(void* arg) {
+
+  struct GC* gc = arg;
+
+  pthread_mutex_lock(&gc->sweep_lock);
+
+  while (true) {
+
+    while (gc->nsweep is 0 and not gc->sweep_stop) {
+      pthread_cond_wait(&gc->sweep_wake, &gc->sweep_lock);
+    }
+
+    if (gc->nsweep is 0) { break; }
+
+    struct GCFinal* items = gc->sweep;
+    size_t nitems = gc->nsweep;
+    gc->sweep = NULL;
+    gc->nsweep = 0;
+    gc->msweep = 0;
+
+    pthread_mutex_unlock(&gc->sweep_lock);
+
+    for (size_t i = 0; i < nitems; i++) {
+      if (items[i].finalize) { items[i].finalize(items[i].self); }
+      if (items[i].slab is NULL) {
+        free((char*)items[i].self - sizeof(struct Header));
+      }
+    }
+
+    pthread_mutex_lock(&gc->sweep_lock);
+
+    /* Slab slots can only be freed by the owning thread */
+    for (size_t i = 0; i < nitems; i++) {
+      if (items[i].slab is NULL) { continue; }
+      gc->returned = GC_Push(gc->returned,
+        &gc->nreturned, &gc->mreturned, items[i].self);
+    }
+    free(items);
+  }
+
+  pthread_mutex_unlock(&gc->sweep_lock);
+
+  return NULL;
+}
+
+static void GC_Sweeper_Return(struct GC* gc, var* items, size_t nitems) {
+  for (size_t i = 0; i < nitems; i++) {
+    GC_Slab_Free(gc, GC_Page(gc, (uintptr_t)items[i] >> GC_PAGE_SHIFT), items[i]);
+  }
+  free(items);
+}
+
+static void GC_Sweeper_Flush(struct GC* gc) {
+
+  pthread_mutex_lock(&gc->sweep_lock);
+
+  var* returned = gc->returned;
+  size_t nreturned = gc->nreturned;
+  gc->returned = NULL;
+  gc->nreturned = 0;
+  gc->mreturned = 0;
+
+  if (gc->nhandoff is 0) {
+    pthread_mutex_unlock(&gc->sweep_lock);
+    GC_Sweeper_Return(gc, returned, nreturned);
+    return;
+  }
+
+  if (gc->sweep is NULL) {
+    gc->sweep = gc->handoff;
+    gc->nsweep = gc->nhandoff;
+    gc->msweep = gc->mhandoff;
+    gc->handoff = NULL;
+    gc->mhandoff = 0;
+  } else {
+    for (size_t i = 0; i < gc->nhandoff; i++) {
+      if (gc->nsweep is gc->msweep) {
+        gc->msweep = gc->msweep * 2;
+        gc->sweep = realloc(gc->sweep, sizeof(struct GCFinal) * gc->msweep);
+#if CELLO_MEMORY_CHECK == 1
+        if (gc->sweep is NULL) {
+          throw(OutOfMemoryError, "Cannot grow GC Sweeper, out of memory!");
+        }
+#endif
+      }
+      gc->sweep[gc->nsweep++] = gc->handoff[i];
+    }
+  }
+
+  gc->nhandoff = 0;
+
+  pthread_cond_signal(&gc->sweep_wake);
+  pthread_mutex_unlock(&gc->sweep_lock);
+
+  GC_Sweeper_Return(gc, returned, nreturned);
+}
+
+static void GC_Sweeper_Push(struct GC* gc, var ptr, struct GCPage* slab) {
+
+  if (gc->nhandoff is gc->mhandoff) {
+    gc->mhandoff = gc->mhandoff is 0 ? 64 : gc->mhandoff * 2;
+    gc->handoff = realloc(gc->handoff, sizeof(struct GCFinal) * gc->mhandoff);
+#if CELLO_MEMORY_CHECK == 1
+    if (gc->handoff is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Sweeper, out of memory!");
+    }
+#endif
+  }
+
+  struct Finalize* f = type_instance(type_of(ptr), Finalize);
+  gc->handoff[gc->nhandoff].self = ptr;
+  gc->handoff[gc->nhandoff].finalize = f ? f->finalize : NULL;
+  gc->handoff[gc->nhandoff].slab = slab;
+  gc->nhandoff++;
+}
+
+static void GC_Sweeper_Start(struct GC* gc) {
+  gc->sweep_stop = false;
+  gc->nsweep = 0;
+  gc->msweep = 0;
+  gc->sweep = NULL;
+  gc->nreturned = 0;
+  gc->mreturned = 0;
+  gc->returned = NULL;
+  pthread_mutex_init(&gc->sweep_lock, NULL);
+  pthread_cond_init(&gc->sweep_wake, NULL);
+  if (pthread_create(&gc->sweep_thread, NULL, GC_Sweeper_Run, gc)) {
+    pthread_mutex_destroy(&gc->sweep_lock);
+    pthread_cond_destroy(&gc->sweep_wake);
+    throw(OutOfMemoryError, "Cannot create GC Sweeper thread!");
+  }
+  gc->sweeper = true;
+}
+
+static void GC_Sweeper_Stop(struct GC* gc) {
+
+  if (not gc->sweeper) { return; }
+
+  GC_Sweeper_Flush(gc);
+
+  pthread_mutex_lock(&gc->sweep_lock);
+  gc->sweep_stop = true;
+  pthread_cond_signal(&gc->sweep_wake);
+  pthread_mutex_unlock(&gc->sweep_lock);
+
+  pthread_join(gc->sweep_thread, NULL);
+  pthread_mutex_destroy(&gc->sweep_lock);
+  pthread_cond_destroy(&gc->sweep_wake);
+
+  GC_Sweeper_Return(gc, gc->returned, gc->nreturned);
+  gc->returned = NULL;
+  gc->nreturned = 0;
+  gc->mreturned = 0;
+
+  free(gc->handoff);
+  gc->handoff = NULL;
+  gc->nhandoff = 0;
+  gc->mhandoff = 0;
+  gc->sweeper = false;
+}
+
+#endif
+
+static void GC_Release(struct GC* gc, var ptr) {
+
+  struct GCPage* p = GC_Page(gc, (uintptr_t)ptr >> GC_PAGE_SHIFT);
+  size_t i = GC_Slot(ptr);
+  if (p is NULL or not GC_Bit(p->dead, i)) { return; }
+
+  GC_Bit_Clear(p->dead, i);
+  GC_Freed(gc, ptr);
+
+  struct GCPage* slab = p->slab isnt 0 ? p : NULL;
+  struct GCChunk* remote = p->remote;
+  GC_Page_Release(gc, p);
+
+  if (remote) {
+    GC_Remote_Free(remote, ptr);
+    return;
+  }
+
+#ifdef GC_SWEEPER
+  if (GC_Deferred(gc, ptr)) {
+    GC_Sweeper_Push(gc, ptr, slab);
+    return;
+  }
+#endif
+
+  if (slab isnt NULL) {
+    GC_Slab_Free(gc, slab, ptr);
+  } else {
+    dealloc(ptr);
+  }
+}
+
+static bool GC_Reclaim(struct GC* gc) {
+
+  /*
+  **  Every dying object is destructed before any memory is freed,
+  **  so destructors may still look at other dead objects. An
+  **  object which was deleted manually in the meantime no longer
+  **  has its dying bit set and is skipped.
+  */
+
+  if (gc->cdying < gc->ndying) {
+    var ptr = gc->dying[gc->cdying++];
+    struct GCPage* p = GC_Page(gc, (uintptr_t)ptr >> GC_PAGE_SHIFT);
+    size_t i = GC_Slot(ptr);
+    if (p is NULL or not GC_Bit(p->dying, i)) { return true; }
+    GC_Bit_Clear(p->dying, i);
+    GC_Bit_Set(p->dead, i);
+    gc->dead = GC_Push(gc->dead, &gc->ndead, &gc->mdead, ptr);
+    if (not GC_Deferred(gc, ptr)) { destruct(ptr); }
+    return true;
+  }
+
+  if (gc->cdead < gc->ndead) {
+    GC_Release(gc, gc->dead[gc->cdead++]);
+    return true;
+  }
+
+  gc->ndying = 0;
+  gc->cdying = 0;
+  gc->ndead = 0;
+  gc->cdead = 0;
+  GC_Slab_Reclaim(gc);
+  return false;
+}
+
+static void GC_Minor(struct GC* gc) {
+  gc->minor = true;
+  GC_Mark(gc);
+  GC_Sweep_Young(gc);
+  gc->minor = false;
+}
+
+/*
+**  The incremental collector runs the same mark and sweep as
+**  above but spreads the work over many allocations using the
+**  tri-color abstraction. White objects are unmarked, gray
+**  objects are marked but still on the `gray` stack waiting for
+**  their children to be scanned, and black objects are marked
+**  and fully scanned.
+**
+**  Because the program runs in between slices it can hide a
+**  white object inside an object which is already black. To
+**  avoid freeing it `gc_barrier` shades written objects gray
+**  again, and when the gray stack runs empty the thread local
+**  storage, stack, and objects allocated during the cycle are
+**  all rescanned in one final step before sweeping begins.
+*/
+
+static void GC_Begin(struct GC* gc) {
+  GC_Flip(gc);
+  gc->phase = GC_MARKING;
+  gc->ngray = 0;
+  gc->nfetch = 0;
+  gc->nallocated = 0;
+  GC_Mark_Roots(gc);
+  GC_Mark_Thread(gc);
+}
+
+static void GC_Remark(struct GC* gc) {
+
+  for (size_t i = 0; i < gc->nallocated; i++) {
+    var ptr = gc->allocated[i];
+    if (GC_Lookup(gc, ptr) isnt NULL) { GC_Recurse(gc, ptr); }
+  }
+
+  GC_Mark_Thread(gc);
+
+  GC_Drain(gc);
+
+  gc->nallocated = 0;
+  GC_Sweep(gc);
+}
+
+static void GC_Step(struct GC* gc, size_t budget, size_t budget_time) {
+
+  if (gc->stepping) { return; }
+  gc->stepping = true;
+
+  uint64_t start = budget_time isnt 0 ? GC_Now() : 0;
+  uint64_t limit = (uint64_t)budget_time * 1000;
+
+  for (size_t work = 0; budget is 0 or work < budget; work++) {
+
+    if (budget_time isnt 0 and work % GC_BUDGET_CLOCK is 0
+    and GC_Now() - start > limit) { break; }
+
+    if (gc->phase is GC_MARKING) {
+
+      if (not GC_Gray(gc)) {
+        GC_Remark(gc);
+        continue;
+      }
+
+      GC_Scan(gc);
+      continue;
+    }
+
+    if (gc->phase is GC_SWEEPING) {
+
+      if (not GC_Reclaim(gc)) {
+        gc->phase = GC_IDLE;
+        break;
+      }
+
+      continue;
+    }
+
+    break;
+  }
+
+#ifdef GC_SWEEPER
+  if (gc->sweeper) { GC_Sweeper_Flush(gc); }
+#endif
+
+  gc->stepping = false;
+}
+
+static void GC_Join(var self) {
+  struct GC* gc = self;
+  if (gc->phase is GC_IDLE) { return; }
+  GC_Step(gc, 0, 0);
+}
+
+static void GC_Abandon(struct GC* gc) {
+  if (gc->phase isnt GC_MARKING) { return; }
+  gc->phase = GC_IDLE;
+  gc->ngray = 0;
+  gc->nfetch = 0;
+  gc->nallocated = 0;
+}
+
+/*
+**  Every allocation looks up the current GC, so where the
+**  compiler supports it a native thread local is kept alongside
+**  the entry in the thread storage and is checked first.
+*/
+
+#ifdef CELLO_TLS
+static CELLO_TLS struct GC* GC_Local = NULL;
+#endif
+
+static var GC_Current(void) {
+#ifdef CELLO_TLS
+  if (GC_Local isnt NULL) { return GC_Local; }
+#endif
+  return get(current(Thread), $S(GC_TLS_KEY));
+}
+
+static void GC_Barrier_Set(struct GC* gc, bool enabled) {
+  if (enabled is gc->barrier) { return; }
+  gc->barrier = enabled;
+#ifndef CELLO_TLS
+  if (enabled) {
+    __atomic_add_fetch(&GC_Barrier_Count, 1, __ATOMIC_RELAXED);
+  } else {
+    __atomic_sub_fetch(&GC_Barrier_Count, 1, __ATOMIC_RELAXED);
+  }
+#endif
+}
+
+static void GC_New(var self, var args) {
+  struct GC* gc = self;
+
+  /* Initialize GC structure first */
+  gc->maxptr = 0;
+  gc->minptr = UINTPTR_MAX;
+  gc->running = true;
+  gc->slab = true;
+  memset(gc->slabs, 0, sizeof(gc->slabs));
+  gc->nchunks = 0;
+  gc->mchunks = 0;
+  gc->chunks = NULL;
+  gc->nspare = 0;
+  gc->mspare = 0;
+  gc->spare = NULL;
+  gc->lent = 0;
+  gc->ndying = 0;
+  gc->mdying = 0;
+  gc->cdying = 0;
+  gc->dying = NULL;
+  gc->ndead = 0;
+  gc->mdead = 0;
+  gc->cdead = 0;
+  gc->dead = NULL;
+  gc->pages = NULL;
+  gc->npages = 0;
+  gc->mpages = 0;
+  gc->index = NULL;
+  gc->nindex = 0;
+  gc->mindex = GC_INDEX_MIN;
+  GC_Index_Resize(gc, GC_INDEX_MIN);
+  gc->nitems = 0;
+  gc->bytes = 0;
+  gc->max_bytes = 0;
+  gc->min_heap = GC_MIN_HEAP;
+  gc->growth = 1.5;
+  GC_Threshold(gc);
+  gc->generational = false;
+  gc->minor = false;
+  gc->barrier = false;
+  gc->nursery = GC_NURSERY_DEFAULT;
+  gc->nyoung = 0;
+  gc->myoung = 0;
+  gc->young = NULL;
+  gc->nremembered = 0;
+  gc->mremembered = 0;
+  gc->remembered = NULL;
+  gc->phase = GC_IDLE;
+  gc->stepping = false;
+  gc->budget = 0;
+  gc->budget_time = 0;
+  gc->ngray = 0;
+  gc->mgray = 0;
+  gc->gray = NULL;
+  gc->nfetch = 0;
+  gc->fetchhead = 0;
+  gc->nallocated = 0;
+  gc->mallocated = 0;
+  gc->allocated = NULL;
+  gc->scanning = NULL;
+  gc->nweak = 0;
+  gc->mweak = 0;
+  gc->weak = NULL;
+  gc->nthreads = 1;
+  gc->profile = false;
+  memset(&gc->stats, 0, sizeof(gc->stats));
+  gc->hook = NULL;
+#ifdef GC_PARALLEL
+  gc->workers = NULL;
+#endif
+#ifdef GC_SWEEPER
+  gc->sweeper = false;
+  gc->nhandoff = 0;
+  gc->mhandoff = 0;
+  gc->handoff = NULL;
+#endif
+
+  /* Handle bottom pointer safely for TinyCC compatibility */
+  var ref_arg = args_get(args, 0);
+  if (ref_arg) {
+    /* Directly access the Ref structure without type checking */
+    struct Ref* bt = (struct Ref*)ref_arg;
+    gc->bottom = bt->val;
+  } else {
+    gc->bottom = NULL;
+  }
+
+  set(current(Thread), $S(GC_TLS_KEY), gc);
+#ifdef CELLO_TLS
+  GC_Local = gc;
+#endif
+}
+
+static void GC_Del(var self) {
+  struct GC* gc = self;
+  gc->hook = NULL;
+  GC_Abandon(gc);
+  GC_Join(gc);
+  GC_Flip(gc);
+  GC_Sweep(gc);
+  GC_Join(gc);
+#ifdef GC_SWEEPER
+  GC_Sweeper_Stop(gc);
+#endif
+  for (size_t i = 0; i < gc->npages; i++) {
+    free(gc->pages[i]->sites);
+    free(gc->pages[i]);
+  }
+  for (size_t i = 0; i < gc->nchunks; i++) {
+    struct GCChunk* c = gc->chunks[i];
+    GC_Remote_Lock();
+    c->orphan = c->lent isnt 0;
+    GC_Remote_Unlock();
+    if (c->orphan) { continue; }
+    free(c->data);
+    free(c);
+  }
+  free(gc->pages);
+  free(gc->index);
+  free(gc->chunks);
+  free(gc->spare);
+  free(gc->dying);
+  free(gc->dead);
+  free(gc->young);
+  free(gc->remembered);
+  free(gc->gray);
+  free(gc->allocated);
+  free(gc->weak);
+#ifdef GC_PARALLEL
+  GC_Par_Stop(gc);
+#endif
+  GC_Barrier_Set(gc, false);
+  rem(current(Thread), $S(GC_TLS_KEY));
+#ifdef CELLO_TLS
+  if (GC_Local is gc) { GC_Local = NULL; }
+#endif
+}
+
+static void GC_Generational_Set(struct GC* gc, bool enabled) {
+
+  if (enabled is gc->generational) { return; }
+
+  /*
+  **  Objects allocated while in the standard mode are not in
+  **  the young list or remembered set, so when switching mode
+  **  everything allocated so far is treated as old.
+  */
+
+  for (size_t i = 0; i < gc->npages; i++) {
+    struct GCPage* p = gc->pages[i];
+    memcpy(p->old, p->objects, sizeof(p->old));
+    memset(p->dirty, 0, sizeof(p->dirty));
+  }
+
+  gc->nyoung = 0;
+  gc->nremembered = 0;
+  gc->generational = enabled;
+  GC_Barrier_Set(gc, gc->generational or gc->budget isnt 0);
+}
+
+static void GC_Incremental_Set(struct GC* gc, size_t budget) {
+  GC_Join(gc);
+  gc->budget = budget;
+  GC_Barrier_Set(gc, gc->generational or gc->budget isnt 0);
+}
+
+static void GC_Threads_Set(struct GC* gc, size_t nthreads) {
+#ifdef GC_PARALLEL
+  GC_Par_Stop(gc);
+  if (nthreads > 1) { GC_Par_Start(gc, nthreads); }
+#endif
+}
+
+static void GC_Sweeper_Set(struct GC* gc, bool enabled) {
+#ifdef GC_SWEEPER
+  GC_Join(gc);
+  GC_Sweeper_Stop(gc);
+  if (enabled) { GC_Sweeper_Start(gc); }
+#endif
+}
+
+void gc_barrier(var self) {
+
+  if (self is NULL) { return; }
+
+  /* Threads write to their storage before their GC is created */
+#ifdef CELLO_TLS
+  struct GC* gc = GC_Local;
+  if (gc is NULL or not gc->barrier) { return; }
+#else
+  if (__atomic_load_n(&GC_Barrier_Count, __ATOMIC_RELAXED) is 0) { return; }
+  var thread = current(Thread);
+  if (not mem(thread, $S(GC_TLS_KEY))) { return; }
+  struct GC* gc = get(thread, $S(GC_TLS_KEY));
+  if (not gc->barrier) { return; }
+#endif
+  if (self is gc) { return; }
+  if (not gc->generational and gc->phase isnt GC_MARKING) { return; }
+
+  struct GCPage* p = GC_Lookup(gc, self);
+  if (p is NULL) { return; }
+  size_t i = GC_Slot(self);
+
+  /* A black object written during marking is shaded gray again */
+  if (gc->phase is GC_MARKING and GC_Bit(p->marks, i)) {
+    gc->gray = GC_Push(gc->gray, &gc->ngray, &gc->mgray, self);
+  }
+
+  if (not gc->generational
+  or  not GC_Bit(p->old, i)
+  or  GC_Bit(p->dirty, i)) { return; }
+
+  GC_Bit_Set(p->dirty, i);
+  gc->remembered = GC_Push(
+    gc->remembered, &gc->nremembered, &gc->mremembered, self);
+}
+
+static void GC_Set(var self, var key, var val) {
+  struct GC* gc = self;
+
+  if (key is GCGenerational) {
+    GC_Generational_Set(gc, c_int(val) isnt 0);
+    return;
+  }
+
+  if (key is GCNursery) {
+    gc->nursery = (size_t)c_int(val);
+    return;
+  }
+
+  if (key is GCIncremental) {
+    GC_Incremental_Set(gc, (size_t)c_int(val));
+    return;
+  }
+
+  if (key is GCTimeBudget) {
+    gc->budget_time = (size_t)c_int(val);
+    return;
+  }
+
+  if (key is GCThreads) {
+    GC_Threads_Set(gc, (size_t)c_int(val));
+    return;
+  }
+
+  if (key is GCSweeper) {
+    GC_Sweeper_Set(gc, c_int(val) isnt 0);
+    return;
+  }
+
+  if (key is GCSlab) {
+    gc->slab = c_int(val) isnt 0;
+    return;
+  }
+
+  if (key is GCGrowth) {
+    gc->growth = c_float(val) < 1.0 ? 1.0 : c_float(val);
+    if (gc->phase is GC_IDLE) { GC_Threshold(gc); }
+    return;
+  }
+
+  if (key is GCMinHeap) {
+    gc->min_heap = (size_t)c_int(val);
+    if (gc->phase is GC_IDLE) { GC_Threshold(gc); }
+    return;
+  }
+
+  if (key is GCMaxBytes) {
+    gc->max_bytes = (size_t)c_int(val);
+    if (gc->phase is GC_IDLE) { GC_Threshold(gc); }
+    return;
+  }
+
+  if (key is GCProfile) {
+    gc->profile = c_int(val) isnt 0;
+    return;
+  }
+
+  if (not gc->running) { return; }
+  gc->maxptr = (uintptr_t)key > gc->maxptr ? (uintptr_t)key : gc->maxptr;
+  gc->minptr = (uintptr_t)key < gc->minptr ? (uintptr_t)key : gc->minptr;
+  if (not GC_Set_Ptr(gc, key, (bool)c_int(val))) { return; }
+
+  if (gc->generational) {
+    gc->young = GC_Push(gc->young, &gc->nyoung, &gc->myoung, key);
+  }
+
+  if (gc->phase is GC_MARKING) {
+    gc->allocated = GC_Push(
+      gc->allocated, &gc->nallocated, &gc->mallocated, key);
+  }
+
+  size_t bytes = GC_Size(key);
+  gc->bytes += bytes;
+  gc->stats.objects_allocated++;
+  gc->stats.bytes_allocated += bytes;
+
+  if (gc->phase isnt GC_IDLE) {
+    uint64_t start = GC_Now();
+    GC_Step(gc, gc->budget isnt 0 ? gc->budget : GC_LAZY, gc->budget_time);
+    GC_Pause(gc, start);
+  } else if (gc->nitems > gc->mitems or gc->bytes > gc->mbytes) {
+    uint64_t start = GC_Now();
+    gc->stats.collections++;
+    GC_Hook(gc, false);
+    if (gc->budget isnt 0) {
+      GC_Begin(gc);
+      GC_Step(gc, gc->budget, gc->budget_time);
+    } else {
+      GC_Mark(gc);
+      GC_Sweep(gc);
+    }
+    GC_Pause(gc, start);
+  } else if (gc->generational and gc->nyoung > gc->nursery) {
+    uint64_t start = GC_Now();
+    gc->stats.minor_collections++;
+    GC_Hook(gc, false);
+    GC_Minor(gc);
+    GC_Pause(gc, start);
+  }
+}
 
-void GC_Mark(struct GC* gc) {
-  
-  if (gc is NULL or gc->nitems is 0) { return; }
-  
-  /* Mark Thread Local Storage */
-  mark(current(Thread), gc, (void(*)(var,void*))GC_Mark_Item);
-  
-  /* Mark Roots */
-  for (size_t i = 0; i < gc->nslots; i++) {
-    if (gc->entries[i].hash is 0) { continue; }
-    if (gc->entries[i].marked) { continue; }
-    if (gc->entries[i].root) {
-      gc->entries[i].marked = true;
-      GC_Recurse(gc, gc->entries[i].ptr);
+void gc_collect(var self) {
+
+  struct GC* gc = self;
+  GC_Join(gc);
+
+  uint64_t start = GC_Now();
+  gc->stats.collections++;
+  GC_Hook(gc, false);
+  GC_Mark(gc);
+  GC_Sweep(gc);
+  GC_Join(gc);
+  GC_Pause(gc, start);
+}
+
+/*
+**  Handing off an object removes it, and every object it reaches
+**  which is owned by this collector, from the collector without
+**  freeing anything. The objects are recorded in a batch keyed on
+**  the handed off object until another collector adopts them.
+**  While gathering them the `dying` bits, which are always clear
+**  once a collection has been joined, mark objects already seen.
+*/
+
+struct GCHandoff {
+  struct GC* gc;
+  size_t nitems;
+  size_t mitems;
+  var* items;
+  size_t nstack;
+  size_t mstack;
+  var* stack;
+};
+
+static void GC_Handoff_Item(void* _h, void* ptr) {
+  struct GCHandoff* h = _h;
+  struct GCPage* p = GC_Lookup(h->gc, ptr);
+  if (p is NULL) { return; }
+  size_t i = GC_Slot(ptr);
+  if (GC_Bit(p->roots, i) or GC_Bit(p->dying, i)) { return; }
+  GC_Bit_Set(p->dying, i);
+  h->items = GC_Push(h->items, &h->nitems, &h->mitems, ptr);
+  h->stack = GC_Push(h->stack, &h->nstack, &h->mstack, ptr);
+}
+
+static void GC_Handoff_Found(void* _h, void* ptr);
+
+static void GC_Handoff_Inner(void* _h, void* ptr) {
+  struct GCHandoff* h = _h;
+  if (ptr is NULL) { return; }
+  if (GC_Lookup(h->gc, ptr) isnt NULL) {
+    GC_Handoff_Item(h, ptr);
+  } else {
+    GC_Trace(h, ptr, GC_Handoff_Item, GC_Handoff_Inner, GC_Handoff_Found);
+  }
+}
+
+/* Weak references go with the objects holding them */
+static void GC_Handoff_Found(void* _h, void* ptr) {
+  if (type_of(ptr) is Weak) {
+    GC_Handoff_Item(_h, ((struct Weak*)ptr)->val);
+  } else {
+    mark(ptr, _h, (void(*)(var,void*))GC_Handoff_Inner);
+  }
+}
+
+static struct GCBatch** GC_Batch_Find(var root) {
+  struct GCBatch** link = &GC_Batches[hash_mix((uintptr_t)root) % GC_BATCHES];
+  while (*link isnt NULL and (*link)->root isnt root) {
+    link = &(*link)->next;
+  }
+  return link;
+}
+
+var gc_handoff(var self, var obj) {
+
+  struct GC* gc = self;
+  GC_Join(gc);
+
+  struct GCHandoff h = { gc, 0, 0, NULL, 0, 0, NULL };
+  GC_Handoff_Item(&h, obj);
+  while (h.nstack > 0) {
+    var ptr = h.stack[--h.nstack];
+    GC_Trace(&h, ptr, GC_Handoff_Item, GC_Handoff_Inner, GC_Handoff_Found);
+  }
+  free(h.stack);
+
+  GC_Remote_Lock();
+
+  struct GCBatch** link = GC_Batch_Find(obj);
+  if (*link is NULL) {
+    *link = calloc(1, sizeof(struct GCBatch));
+#if CELLO_MEMORY_CHECK == 1
+    if (*link is NULL) {
+      GC_Remote_Unlock();
+      throw(OutOfMemoryError, "Cannot allocate GC Batch, out of memory!");
     }
+#endif
+    (*link)->root = obj;
   }
-  
-  volatile int noinline = 1;
-  
-  /* Flush Registers to Stack */
-  if (noinline) {
-    jmp_buf env;
-    memset(&env, 0, sizeof(jmp_buf));
-    setjmp(env);
+
+  struct GCBatch* b = *link;
+  if (b->nitems + h.nitems > b->mitems) {
+    b->mitems = b->nitems + h.nitems;
+    b->items = realloc(b->items, sizeof(struct GCLent) * b->mitems);
+#if CELLO_MEMORY_CHECK == 1
+    if (b->items is NULL) {
+      GC_Remote_Unlock();
+      throw(OutOfMemoryError, "Cannot grow GC Batch, out of memory!");
+    }
+#endif
   }
-  
-  /* Avoid Inlining function call */
-  void (*mark_stack)(struct GC* gc) = noinline
-    ? GC_Mark_Stack
-    : (void(*)(struct GC* gc))(NULL);
-  
-  /* Mark Stack */
-  mark_stack(gc);
-  
+
+  /* Slab slots stay allocated and are lent out by their chunk */
+  for (size_t j = 0; j < h.nitems; j++) {
+    var ptr = h.items[j];
+    struct GCPage* p = GC_Lookup(gc, ptr);
+    size_t i = GC_Slot(ptr);
+    struct GCChunk* c = p->slab isnt 0 ? p->chunk : p->remote;
+    if (p->slab isnt 0) {
+      c->lent++;
+      gc->lent++;
+    }
+    b->items[b->nitems].ptr = ptr;
+    b->items[b->nitems].chunk = c;
+    b->nitems++;
+    GC_Bit_Clear(p->dying, i);
+    GC_Del_Ptr(gc, p, i);
+    GC_Page_Release(gc, p);
+  }
+
+  GC_Remote_Unlock();
+
+  free(h.items);
+  return obj;
 }
 
-static int GC_Show(var self, var out, int pos) {
+var gc_adopt(var self, var obj) {
+
   struct GC* gc = self;
- 
-  pos = print_to(out, pos, "<'GC' At 0x%p\n", self);
-  for (size_t i = 0; i < gc->nslots; i++) {
-    if (gc->entries[i].hash is 0) {
-      pos = print_to(out, pos, "| %i : \n", $I(i));
-      continue;
+
+  GC_Remote_Lock();
+  struct GCBatch** link = GC_Batch_Find(obj);
+  struct GCBatch* b = *link;
+  if (b isnt NULL) { *link = b->next; }
+  GC_Remote_Unlock();
+
+  if (b is NULL) {
+    return throw(ValueError, "Object %$ has not been handed off!", obj);
+  }
+
+  GC_Join(gc);
+
+  for (size_t i = 0; i < b->nitems; i++) {
+    var ptr = b->items[i].ptr;
+    gc->maxptr = (uintptr_t)ptr > gc->maxptr ? (uintptr_t)ptr : gc->maxptr;
+    gc->minptr = (uintptr_t)ptr < gc->minptr ? (uintptr_t)ptr : gc->minptr;
+    if (not GC_Set_Ptr(gc, ptr, false)) { continue; }
+    /* A slot coming back to its own slab is no longer lent */
+    struct GCPage* p = GC_Page(gc, (uintptr_t)ptr >> GC_PAGE_SHIFT);
+    struct GCChunk* c = b->items[i].chunk;
+    if (p->slab isnt 0 and p->chunk is c) {
+      GC_Remote_Lock();
+      c->lent--;
+      gc->lent--;
+      GC_Remote_Unlock();
+    } else if (c isnt NULL) {
+      p->remote = c;
+    }
+    if (gc->generational) {
+      gc->young = GC_Push(gc->young, &gc->nyoung, &gc->myoung, ptr);
     }
-    pos = print_to(out, pos, "| %i : %15s %p %s %s\n", 
-      $I(i), type_of(gc->entries[i].ptr), 
-      gc->entries[i].ptr, 
-      gc->entries[i].root ? $S("root") : $S("auto"),
-      gc->entries[i].marked ? $S("*") : $S(" "));
+    gc->bytes += GC_Size(ptr);
   }
-  
-  return print_to(out, pos, "+------------------->\n");
+
+  free(b->items);
+  free(b);
+  return obj;
 }
 
-void GC_Sweep(struct GC* gc) {
-   
-  gc->freelist = realloc(gc->freelist, sizeof(var) * gc->nitems);
-  gc->freenum = 0;
-  
-  size_t i = 0;
-  while (i < gc->nslots) {
-    
-    if (gc->entries[i].hash is 0) { i++; continue; }
-    if (gc->entries[i].marked) { i++; continue; }
-    
-    if (not gc->entries[i].root and not gc->entries[i].marked) {
-      
-      gc->freelist[gc->freenum] = gc->entries[i].ptr;
-      gc->freenum++;
-      memset(&gc->entries[i], 0, sizeof(struct GCEntry));
-      
-      uint64_t j = i;
-      while (true) { 
-        uint64_t nj = (j+1) % gc->nslots;
-        uint64_t nh = gc->entries[nj].hash;
-        if (nh isnt 0 and GC_Probe(gc, nj, nh) > 0) {
-          memcpy(&gc->entries[j], &gc->entries[nj], sizeof(struct GCEntry));
-          memset(&gc->entries[nj], 0, sizeof(struct GCEntry));
-          j = nj;
-        } else {
-          break;
-        }  
+/*
+**  Searches everything held by objects on the heap for a pointer
+**  accepted by `f`. This is used by `Arena` in debug builds to
+**  check that nothing still refers to its memory once stopped.
+*/
+
+struct GCFind {
+  struct GC* gc;
+  bool (*f)(var, var);
+  var ctx;
+  var found;
+};
+
+static void GC_Find_Item(void* _s, void* ptr) {
+  struct GCFind* s = _s;
+  if (s->found is NULL and ptr isnt NULL and s->f(ptr, s->ctx)) {
+    s->found = ptr;
+  }
+}
+
+static void GC_Find_Found(void* _s, void* ptr);
+
+static void GC_Find_Inner(void* _s, void* ptr) {
+  struct GCFind* s = _s;
+  GC_Find_Item(s, ptr);
+  if (ptr is NULL or s->found isnt NULL
+  or  GC_Lookup(s->gc, ptr) isnt NULL) { return; }
+  GC_Trace(s, ptr, GC_Find_Item, GC_Find_Inner, GC_Find_Found);
+}
+
+static void GC_Find_Found(void* _s, void* ptr) {
+  if (type_of(ptr) is Weak) {
+    GC_Find_Item(_s, ((struct Weak*)ptr)->val);
+  } else {
+    mark(ptr, _s, (void(*)(var,void*))GC_Find_Inner);
+  }
+}
+
+var gc_find(var self, bool (*f)(var, var), var ctx) {
+
+  struct GC* gc = self;
+  struct GCFind s = { gc, f, ctx, NULL };
+
+  for (size_t i = 0; i < gc->npages and s.found is NULL; i++) {
+    struct GCPage* p = gc->pages[i];
+    for (size_t w = 0; w < GC_PAGE_WORDS and s.found is NULL; w++) {
+      uint64_t bits = p->objects[w];
+      for (size_t b = 0; bits isnt 0; b++, bits >>= 1) {
+        if (not (bits & 1)) { continue; }
+        GC_Trace(&s, GC_Slot_Ptr(p, w * 64 + b),
+          GC_Find_Item, GC_Find_Inner, GC_Find_Found);
       }
-      
-      gc->nitems--;
-      continue;
     }
-    
-    i++;
   }
-  
-  for (size_t i = 0; i < gc->nslots; i++) {
-    if (gc->entries[i].hash is 0) { continue; }
-    if (gc->entries[i].marked) {
-      gc->entries[i].marked = false;
-      continue;
+
+  return s.found;
+}
+
+void gc_site(var self, var obj, void* site) {
+
+  struct GC* gc = self;
+  if (not gc->profile) { return; }
+
+  struct GCPage* p = GC_Lookup(gc, obj);
+  if (p is NULL) { return; }
+
+  if (p->sites is NULL) {
+    p->sites = calloc(GC_PAGE_SLOTS, sizeof(void*));
+#if CELLO_MEMORY_CHECK == 1
+    if (p->sites is NULL) {
+      throw(OutOfMemoryError, "Cannot allocate GC Sites, out of memory!");
     }
+#endif
   }
-  
-  GC_Resize_Less(gc);
-  gc->mitems = gc->nitems + gc->nitems / 2 + 1;
-  
-  for (size_t i = 0; i < gc->freenum; i++) {
-    if (gc->freelist[i]) {
-      dealloc(destruct(gc->freelist[i]));
+
+  p->sites[GC_Slot(obj)] = site;
+}
+
+/*
+**  A snapshot gives every object an index using a temporary open
+**  addressing table and records the edges between them. Retained
+**  sizes are estimated from a spanning forest of this graph grown
+**  first from objects nothing else on the heap refers to. Each
+**  object is charged to whichever object first reached it, and a
+**  type is charged for the trees below its outermost instances.
+*/
+
+struct GCSnap {
+  struct GC* gc;
+  var* objs;
+  size_t nobjs;
+  size_t* table;
+  size_t ntable;
+  size_t* edges;
+  size_t nedges;
+  size_t medges;
+  size_t from;
+};
+
+struct GCSnapItem {
+  var type;
+  void* site;
+  size_t count;
+  size_t bytes;
+  size_t retained;
+  const char* name;
+};
+
+static size_t GC_Snap_Hash(struct GCSnap* s, var ptr) {
+  return (size_t)(hash_mix((uintptr_t)ptr) & (s->ntable - 1));
+}
+
+static size_t GC_Snap_Find(struct GCSnap* s, var ptr) {
+  for (size_t i = GC_Snap_Hash(s, ptr);; i = (i + 1) & (s->ntable - 1)) {
+    if (s->table[i] is 0) { return SIZE_MAX; }
+    if (s->objs[s->table[i] - 1] is ptr) { return s->table[i] - 1; }
+  }
+}
+
+static void GC_Snap_Item(void* _s, void* ptr) {
+  struct GCSnap* s = _s;
+  if (GC_Lookup(s->gc, ptr) is NULL) { return; }
+  size_t to = GC_Snap_Find(s, ptr);
+  if (to is SIZE_MAX or to is s->from) { return; }
+  if (s->nedges is s->medges) {
+    s->medges = s->medges is 0 ? 1024 : s->medges * 2;
+    s->edges = realloc(s->edges, sizeof(size_t) * s->medges);
+#if CELLO_MEMORY_CHECK == 1
+    if (s->edges is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Snapshot, out of memory!");
     }
+#endif
   }
-  
-  free(gc->freelist);
-  gc->freelist = NULL;
-  gc->freenum = 0;
-  
+  s->edges[s->nedges++] = to;
 }
 
-static var GC_Current(void) {
-  return get(current(Thread), $S(GC_TLS_KEY));
+static void GC_Snap_Found(void* _s, void* ptr) {
+  (void)_s;
+  (void)ptr;
 }
 
-static void GC_New(var self, var args) {
-  struct GC* gc = self;
-  
-  /* Initialize GC structure first */
-  gc->maxptr = 0;
-  gc->minptr = UINTPTR_MAX;
-  gc->running = true;
-  gc->freelist = NULL;
-  gc->freenum = 0;
-  gc->entries = calloc(GC_Ideal_Size(1), sizeof(struct GCEntry));
-  gc->nslots = GC_Ideal_Size(1);
-  gc->nitems = 0;
-  gc->mitems = 1;
-  
-  /* Handle bottom pointer safely for TinyCC compatibility */
-  var ref_arg = get(args, $I(0));
-  if (ref_arg) {
-    /* Directly access the Ref structure without type checking */
-    struct Ref* bt = (struct Ref*)ref_arg;
-    gc->bottom = bt->val;
+static void GC_Snap_Inner(void* _s, void* ptr) {
+  struct GCSnap* s = _s;
+  if (ptr is NULL) { return; }
+  if (GC_Lookup(s->gc, ptr) isnt NULL) {
+    GC_Snap_Item(s, ptr);
   } else {
-    gc->bottom = NULL;
+    GC_Trace(s, ptr, GC_Snap_Item, GC_Snap_Inner, GC_Snap_Found);
   }
-  
-  set(current(Thread), $S(GC_TLS_KEY), gc);
 }
 
-static void GC_Del(var self) {
+static int GC_Snap_Cmp_Key(const void* x, const void* y) {
+  const struct GCSnapItem* a = x;
+  const struct GCSnapItem* b = y;
+  if (a->site isnt b->site) {
+    return (uintptr_t)a->site > (uintptr_t)b->site ? 1 : -1;
+  }
+  if (a->type isnt b->type) {
+    return (uintptr_t)a->type > (uintptr_t)b->type ? 1 : -1;
+  }
+  return 0;
+}
+
+static int GC_Snap_Cmp_Name(const void* x, const void* y) {
+  const struct GCSnapItem* a = x;
+  const struct GCSnapItem* b = y;
+  int c = strcmp(a->name, b->name);
+  return c isnt 0 ? c : strcmp(c_str(a->type), c_str(b->type));
+}
+
+/* Sorts items and merges those with the same site and type */
+static size_t GC_Snap_Merge(struct GCSnapItem* items, size_t nitems) {
+  qsort(items, nitems, sizeof(struct GCSnapItem), GC_Snap_Cmp_Key);
+  size_t n = 0;
+  for (size_t i = 0; i < nitems; i++) {
+    if (n > 0 and GC_Snap_Cmp_Key(&items[n-1], &items[i]) is 0) {
+      items[n-1].count += items[i].count;
+      items[n-1].bytes += items[i].bytes;
+      items[n-1].retained += items[i].retained;
+    } else {
+      items[n++] = items[i];
+    }
+  }
+  return n;
+}
+
+void gc_snapshot(var self, var out) {
+
   struct GC* gc = self;
-  GC_Sweep(gc);
-  free(gc->entries);
-  free(gc->freelist);
-  rem(current(Thread), $S(GC_TLS_KEY));
+  GC_Join(gc);
+
+  struct GCSnap s = { gc, NULL, 0, NULL, 0, NULL, 0, 0, 0 };
+
+  s.objs = malloc(sizeof(var) * (gc->nitems + 1));
+  s.ntable = 1;
+  while (s.ntable < gc->nitems * 2 + 2) { s.ntable *= 2; }
+  s.table = calloc(s.ntable, sizeof(size_t));
+
+#if CELLO_MEMORY_CHECK == 1
+  if (s.objs is NULL or s.table is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate GC Snapshot, out of memory!");
+  }
+#endif
+
+  for (size_t i = 0; i < gc->npages; i++) {
+    struct GCPage* p = gc->pages[i];
+    for (size_t w = 0; w < GC_PAGE_WORDS; w++) {
+      uint64_t bits = p->objects[w];
+      for (size_t b = 0; bits isnt 0; b++, bits >>= 1) {
+        if (not (bits & 1)) { continue; }
+        var ptr = GC_Slot_Ptr(p, w * 64 + b);
+        size_t j = GC_Snap_Hash(&s, ptr);
+        while (s.table[j] isnt 0) { j = (j + 1) & (s.ntable - 1); }
+        s.objs[s.nobjs++] = ptr;
+        s.table[j] = s.nobjs;
+      }
+    }
+  }
+
+  size_t n = s.nobjs;
+  size_t* start = malloc(sizeof(size_t) * (n + 1));
+  size_t* parent = malloc(sizeof(size_t) * (n + 1));
+  size_t* order = malloc(sizeof(size_t) * (n + 1));
+  size_t* stack = malloc(sizeof(size_t) * (n + 1));
+  size_t* indeg = calloc(n + 1, sizeof(size_t));
+  size_t* retained = malloc(sizeof(size_t) * (n + 1));
+  bool* seen = calloc(n + 1, sizeof(bool));
+  struct GCSnapItem* items = calloc(n + 1, sizeof(struct GCSnapItem));
+
+#if CELLO_MEMORY_CHECK == 1
+  if (start is NULL or parent is NULL or order is NULL or stack is NULL
+  or  indeg is NULL or retained is NULL or seen is NULL or items is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate GC Snapshot, out of memory!");
+  }
+#endif
+
+  /* Edges are found in order so each object's edges are contiguous */
+  for (size_t i = 0; i < n; i++) {
+    start[i] = s.nedges;
+    s.from = i;
+    GC_Trace(&s, s.objs[i], GC_Snap_Item, GC_Snap_Inner, GC_Snap_Found);
+    parent[i] = SIZE_MAX;
+    retained[i] = GC_Size(s.objs[i]);
+  }
+  start[n] = s.nedges;
+
+  for (size_t i = 0; i < s.nedges; i++) { indeg[s.edges[i]]++; }
+
+  /* Objects left over after the first pass are only found in cycles */
+  size_t norder = 0;
+  for (size_t pass = 0; pass < 2; pass++) {
+    for (size_t i = 0; i < n; i++) {
+      if (seen[i] or (pass is 0 and indeg[i] isnt 0)) { continue; }
+      size_t nstack = 0;
+      seen[i] = true;
+      stack[nstack++] = i;
+      while (nstack > 0) {
+        size_t o = stack[--nstack];
+        order[norder++] = o;
+        for (size_t e = start[o]; e < start[o+1]; e++) {
+          size_t c = s.edges[e];
+          if (seen[c]) { continue; }
+          seen[c] = true;
+          parent[c] = o;
+          stack[nstack++] = c;
+        }
+      }
+    }
+  }
+
+  /* Children are always ordered after their parents */
+  for (size_t k = norder; k-- > 0;) {
+    size_t o = order[k];
+    if (parent[o] isnt SIZE_MAX) { retained[parent[o]] += retained[o]; }
+  }
+
+  size_t total = 0;
+  for (size_t i = 0; i < n; i++) {
+    var type = type_of(s.objs[i]);
+    bool outer = parent[i] is SIZE_MAX or type_of(s.objs[parent[i]]) isnt type;
+    items[i].type = type;
+    items[i].site = NULL;
+    items[i].count = 1;
+    items[i].bytes = GC_Size(s.objs[i]);
+    items[i].retained = outer ? retained[i] : 0;
+    total += items[i].bytes;
+  }
+
+  size_t ntypes = GC_Snap_Merge(items, n);
+  for (size_t i = 0; i < ntypes; i++) { items[i].name = c_str(items[i].type); }
+  qsort(items, ntypes, sizeof(struct GCSnapItem), GC_Snap_Cmp_Name);
+
+  int pos = 0;
+  pos = print_to(out, pos, "# Cello Heap Snapshot\n");
+  pos = print_to(out, pos, "objects\t%i\n", $I(n));
+  pos = print_to(out, pos, "bytes\t%i\n", $I(total));
+  pos = print_to(out, pos, "\n# type\tcount\tbytes\tretained\n");
+  for (size_t i = 0; i < ntypes; i++) {
+    pos = print_to(out, pos, "%s\t%i\t%i\t%i\n", $S((char*)items[i].name),
+      $I(items[i].count), $I(items[i].bytes), $I(items[i].retained));
+  }
+
+  /* Objects allocated while profiling was off have no site */
+  size_t nsites = 0;
+  for (size_t i = 0; i < n; i++) {
+    struct GCPage* p = GC_Lookup(gc, s.objs[i]);
+    void* site = p->sites isnt NULL ? p->sites[GC_Slot(s.objs[i])] : NULL;
+    if (site is NULL) { continue; }
+    struct GCSnapItem item = {
+      type_of(s.objs[i]), site, 1, GC_Size(s.objs[i]), 0, NULL };
+    items[nsites++] = item;
+  }
+
+  nsites = GC_Snap_Merge(items, nsites);
+
+  void** sites = malloc(sizeof(void*) * (nsites + 1));
+  char* buffer = malloc(32 * (nsites + 1));
+  for (size_t i = 0; i < nsites; i++) { sites[i] = items[i].site; }
+
+#if defined(CELLO_UNIX) && !defined(CELLO_NSTRACE)
+  char** symbols = backtrace_symbols(sites, (int)nsites);
+#else
+  char** symbols = NULL;
+#endif
+
+  /* Absolute addresses are dropped where possible so runs can be compared */
+  for (size_t i = 0; i < nsites; i++) {
+    snprintf(buffer + i * 32, 32, "%p", sites[i]);
+    items[i].name = symbols isnt NULL ? symbols[i] : buffer + i * 32;
+    char* absolute = symbols isnt NULL ? strstr(symbols[i], " [") : NULL;
+    if (absolute isnt NULL and absolute isnt symbols[i]) { *absolute = '\0'; }
+  }
+  qsort(items, nsites, sizeof(struct GCSnapItem), GC_Snap_Cmp_Name);
+
+  if (nsites > 0) {
+    pos = print_to(out, pos, "\n# site\ttype\tcount\tbytes\n");
+  }
+  for (size_t i = 0; i < nsites; i++) {
+    pos = print_to(out, pos, "%s\t%s\t%i\t%i\n",
+      $S((char*)items[i].name), $S((char*)c_str(items[i].type)),
+      $I(items[i].count), $I(items[i].bytes));
+  }
+
+  free(symbols); free(sites); free(buffer);
+  free(start); free(parent); free(order); free(stack); free(indeg);
+  free(retained); free(seen); free(items);
+  free(s.objs); free(s.table); free(s.edges);
 }
 
-static void GC_Set(var self, var key, var val) {
+static void GC_Resize(var self, size_t n) {
+
   struct GC* gc = self;
-  if (not gc->running) { return; }
-  gc->nitems++;
-  gc->maxptr = (uintptr_t)key > gc->maxptr ? (uintptr_t)key : gc->maxptr;
-  gc->minptr = (uintptr_t)key < gc->minptr ? (uintptr_t)key : gc->minptr;
-  GC_Resize_More(gc);
-  GC_Set_Ptr(gc, key, (bool)c_int(val));
-  if (gc->nitems > gc->mitems) {
-    GC_Mark(gc);
-    GC_Sweep(gc);
+
+  /* Assume densely packed objects of a few slots each */
+  size_t pages = gc->npages + n / (GC_PAGE_SLOTS / GC_RESERVE_SLOTS) + 1;
+
+  size_t nindex = gc->nindex;
+  while (pages * 2 > nindex) { nindex *= 2; }
+  gc->mindex = nindex;
+  if (nindex > gc->nindex) { GC_Index_Resize(gc, nindex); }
+
+  if (pages > gc->mpages) {
+    gc->mpages = pages;
+    gc->pages = realloc(gc->pages, sizeof(struct GCPage*) * gc->mpages);
+#if CELLO_MEMORY_CHECK == 1
+    if (gc->pages is NULL) {
+      throw(OutOfMemoryError, "Cannot grow GC Pages, out of memory!");
+    }
+#endif
   }
+
+  if (gc->nitems + n > gc->mitems) { gc->mitems = gc->nitems + n; }
+}
+
+void gc_stats(var self, struct GCStats* stats) {
+  struct GC* gc = self;
+  *stats = gc->stats;
+  stats->objects = gc->nitems;
+  stats->pages = gc->npages;
+  stats->load_factor = (double)gc->npages / gc->nindex;
+}
+
+void gc_hook(var self, void (*f)(var gc, bool end)) {
+  struct GC* gc = self;
+  gc->hook = f;
 }
 
 static void GC_Rem(var self, var key) {
   struct GC* gc = self;
+
+  if (key is GCGenerational) {
+    GC_Generational_Set(gc, false);
+    return;
+  }
+
+  if (key is GCNursery) {
+    gc->nursery = GC_NURSERY_DEFAULT;
+    return;
+  }
+
+  if (key is GCIncremental) {
+    GC_Incremental_Set(gc, 0);
+    return;
+  }
+
+  if (key is GCTimeBudget) {
+    gc->budget_time = 0;
+    return;
+  }
+
+  if (key is GCThreads) {
+    GC_Threads_Set(gc, 1);
+    return;
+  }
+
+  if (key is GCSweeper) {
+    GC_Sweeper_Set(gc, false);
+    return;
+  }
+
+  if (key is GCSlab) {
+    gc->slab = false;
+    return;
+  }
+
+  if (key is GCProfile) {
+    gc->profile = false;
+    for (size_t i = 0; i < gc->npages; i++) {
+      free(gc->pages[i]->sites);
+      gc->pages[i]->sites = NULL;
+    }
+    return;
+  }
+
+  if (key is GCGrowth or key is GCMinHeap or key is GCMaxBytes) {
+    if (key is GCGrowth) { gc->growth = 1.5; }
+    if (key is GCMinHeap) { gc->min_heap = GC_MIN_HEAP; }
+    if (key is GCMaxBytes) { gc->max_bytes = 0; }
+    if (gc->phase is GC_IDLE) { GC_Threshold(gc); }
+    return;
+  }
+
   if (not gc->running) { return; }
   GC_Rem_Ptr(gc, key);
-  GC_Resize_Less(gc);
-  gc->mitems = gc->nitems + gc->nitems / 2 + 1;
 }
 
 static bool GC_Mem(var self, var key) {
-  return GC_Mem_Ptr(self, key);
+  struct GC* gc = self;
+  if (key is GCGenerational) { return gc->generational; }
+  if (key is GCIncremental) { return gc->budget isnt 0; }
+  if (key is GCTimeBudget) { return gc->budget_time isnt 0; }
+  if (key is GCThreads) { return gc->nthreads > 1; }
+  if (key is GCSlab) { return gc->slab; }
+  if (key is GCMaxBytes) { return gc->max_bytes isnt 0; }
+  if (key is GCProfile) { return gc->profile; }
+  if (key is GCNursery or key is GCGrowth or key is GCMinHeap) { return true; }
+#ifdef GC_SWEEPER
+  if (key is GCSweeper) { return gc->sweeper; }
+#else
+  if (key is GCSweeper) { return false; }
+#endif
+  return GC_Mem_Ptr(gc, key);
 }
 
 static void GC_Start(var self) {
@@ -557,11 +3276,12 @@ static bool GC_Running(var self) {
 
 var GC = Cello(GC,
   Instance(Doc,
-    GC_Name, GC_Brief,    GC_Description, 
+    GC_Name, GC_Brief,    GC_Description,
     NULL,    GC_Examples, NULL),
   Instance(New,     GC_New, GC_Del),
   Instance(Get,     NULL, GC_Set, GC_Mem, GC_Rem),
-  Instance(Start,   GC_Start, GC_Stop, NULL, GC_Running),
+  Instance(Start,   GC_Start, GC_Stop, GC_Join, GC_Running),
+  Instance(Resize,  GC_Resize),
   Instance(Show,    GC_Show, NULL),
   Instance(Current, GC_Current));
 
@@ -106,6 +106,9 @@ var get(var self, var key) {
 
 void set(var self, var key, var val) {
   method(self, Get, set, key, val);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
 }
 
 bool mem(var self, var key) {
@@ -65,6 +65,12 @@ static struct Method* Hash_Methods(void) {
       "uint64_t hash_data(void* data, size_t num);",
       "Hash `num` bytes pointed to by `data` using "
       "[Murmurhash](http://en.wikipedia.org/wiki/MurmurHash)."
+    }, {
+      "hash_mix", 
+      "uint64_t hash_mix(uint64_t h);",
+      "Finalize the hash value `h` so that every bit of the input affects "
+      "every bit of the output. Useful before masking a weak hash down to "
+      "a power of two."
     }, {NULL, NULL, NULL}
   };
   
@@ -114,6 +120,15 @@ uint64_t hash_data(const void* data, size_t size) {
 	return h;
 
 }
+
+uint64_t hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
     
 uint64_t hash(var self) {
   
@@ -31,8 +31,8 @@ static void FileReader_New(var self, var args) {
     fr->filename = NULL;
     fr->owns_file = true;
     
-    if (len(args) > 0) {
-        const char* filename = c_str(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        const char* filename = c_str(args_get(args, 0));
         fr->filename = malloc(strlen(filename) + 1);
         strcpy(fr->filename, filename);
         fr->file = fopen(filename, "r");
@@ -66,8 +66,8 @@ static void FileWriter_New(var self, var args) {
     fw->filename = NULL;
     fw->owns_file = true;
     
-    if (len(args) > 0) {
-        const char* filename = c_str(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        const char* filename = c_str(args_get(args, 0));
         fw->filename = malloc(strlen(filename) + 1);
         strcpy(fw->filename, filename);
         fw->file = fopen(filename, "w");
@@ -103,11 +103,11 @@ static void BufferedReader_New(var self, var args) {
     br->buffer_pos = 0;
     br->buffer_len = 0;
     
-    if (len(args) > 0) {
-        br->reader = get(args, $I(0));
+    if (args_len(args) > 0) {
+        br->reader = args_get(args, 0);
     }
-    if (len(args) > 1) {
-        br->buffer_size = c_int(get(args, $I(1)));
+    if (args_len(args) > 1) {
+        br->buffer_size = c_int(args_get(args, 1));
     }
     
     br->buffer = malloc(br->buffer_size);
@@ -137,11 +137,11 @@ static void BufferedWriter_New(var self, var args) {
     bw->buffer_size = DEFAULT_BUFFER_SIZE;
     bw->buffer_pos = 0;
     
-    if (len(args) > 0) {
-        bw->writer = get(args, $I(0));
+    if (args_len(args) > 0) {
+        bw->writer = args_get(args, 0);
     }
-    if (len(args) > 1) {
-        bw->buffer_size = c_int(get(args, $I(1)));
+    if (args_len(args) > 1) {
+        bw->buffer_size = c_int(args_get(args, 1));
     }
     
     bw->buffer = malloc(bw->buffer_size);
@@ -171,8 +171,8 @@ static void StringReader_New(var self, var args) {
     sr->position = 0;
     sr->owns_data = false;
     
-    if (len(args) > 0) {
-        const char* data = c_str(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        const char* data = c_str(args_get(args, 0));
         sr->length = strlen(data);
         sr->data = malloc(sr->length + 1);
         strcpy(sr->data, data);
@@ -229,8 +229,8 @@ static void Path_New(var self, var args) {
     p->path = NULL;
     p->length = 0;
     
-    if (len(args) > 0) {
-        const char* path = c_str(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        const char* path = c_str(args_get(args, 0));
         p->length = strlen(path);
         p->path = malloc(p->length + 1);
         strcpy(p->path, path);
@@ -192,7 +192,7 @@ static struct Method* Range_Methods(void) {
 var range_stack(var self, var args) {
   
   struct Range* r = self;
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
   
   if (nargs > 3) {
     throw(FormatError, "Received too many arguments to Range constructor");
@@ -206,18 +206,18 @@ var range_stack(var self, var args) {
     break;
     case 1:
       r->start = 0;
-      r->stop  = c_int(get(args, $I(0)));
+      r->stop  = c_int(args_get(args, 0));
       r->step  = 1;
     break;
     case 2:
-      r->start = get(args, $I(0)) is _ ? 0 : c_int(get(args, $I(0)));
-      r->stop  = c_int(get(args, $I(1)));
+      r->start = args_get(args, 0) is _ ? 0 : c_int(args_get(args, 0));
+      r->stop  = c_int(args_get(args, 1));
       r->step  = 1;
     break;
     case 3:
-      r->start = get(args, $I(0)) is _ ? 0 : c_int(get(args, $I(0)));
-      r->stop  = c_int(get(args, $I(1)));
-      r->step  = get(args, $I(2)) is _ ? 1 : c_int(get(args, $I(2)));
+      r->start = args_get(args, 0) is _ ? 0 : c_int(args_get(args, 0));
+      r->stop  = c_int(args_get(args, 1));
+      r->step  = args_get(args, 2) is _ ? 1 : c_int(args_get(args, 2));
     break;
   }
   
@@ -358,6 +358,10 @@ static int Range_Show(var self, var output, int pos) {
   return print_to(output, pos, "]>");
 }
 
+static uint64_t Range_Layout(void) {
+  return layout_of(Range, value);
+}
+
 var Range = Cello(Range,
   Instance(Doc,
     Range_Name,       Range_Brief,    Range_Description, 
@@ -368,6 +372,7 @@ var Range = Cello(Range,
   Instance(Len,       Range_Len),
   Instance(Get,       Range_Get, NULL, Range_Mem, NULL),
   Instance(Show,      Range_Show, NULL),
+  Instance(Layout,    Range_Layout),
   Instance(Iter, 
     Range_Iter_Init,  Range_Iter_Next, 
     Range_Iter_Last,  Range_Iter_Prev, Range_Iter_Type));
@@ -471,7 +476,7 @@ static int64_t Slice_Arg(int part, size_t n, var arg) {
 
 var slice_stack(var self, var args) {
   
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
 
   if (nargs > 4) {
     throw(FormatError, "Received too many arguments to Slice constructor");
@@ -482,7 +487,7 @@ var slice_stack(var self, var args) {
   }
   
   struct Slice* s = self;
-  s->iter  = get(args, $I(0));
+  s->iter  = args_get(args, 0);
   
   struct Range* r = s->range;
   size_t n = len(s->iter);
@@ -495,18 +500,18 @@ var slice_stack(var self, var args) {
     break;
     case 2:
       r->start = 0;
-      r->stop  = Slice_Arg(1, n, get(args, $I(1)));
+      r->stop  = Slice_Arg(1, n, args_get(args, 1));
       r->step  = 1;
     break;
     case 3:
-      r->start = Slice_Arg(0, n, get(args, $I(1)));
-      r->stop  = Slice_Arg(1, n, get(args, $I(2)));
+      r->start = Slice_Arg(0, n, args_get(args, 1));
+      r->stop  = Slice_Arg(1, n, args_get(args, 2));
       r->step  = 1;
     break;
     case 4:
-      r->start = Slice_Arg(0, n, get(args, $I(1)));
-      r->stop  = Slice_Arg(1, n, get(args, $I(2)));
-      r->step  = Slice_Arg(2, n, get(args, $I(3)));
+      r->start = Slice_Arg(0, n, args_get(args, 1));
+      r->stop  = Slice_Arg(1, n, args_get(args, 2));
+      r->step  = Slice_Arg(2, n, args_get(args, 3));
     break;
   }
   
@@ -757,7 +762,8 @@ static void Zip_New(var self, var args) {
   z->iters = new(Tuple);
   z->values = new(Tuple);
   assign(z->iters, args);
-  for (size_t i = 0; i < len(args); i++) {
+  size_t nargs = args_len(args);
+  for (size_t i = 0; i < nargs; i++) {
     push(z->values, _);
   }
 }
@@ -962,8 +968,8 @@ static struct Method* Filter_Methods(void) {
 
 static void Filter_New(var self, var args) {
   struct Filter* f = self;
-  f->iter = get(args, $I(0));
-  f->func = get(args, $I(1));
+  f->iter = args_get(args, 0);
+  f->func = args_get(args, 1);
 }
 
 static var Filter_Iter_Init(var self) {
@@ -1123,8 +1129,8 @@ static struct Example* Map_Examples(void) {
 
 static void Map_New(var self, var args) {
   struct Map* m = self;
-  m->iter = get(args, $I(0));
-  m->func = get(args, $I(1));
+  m->iter = args_get(args, 0);
+  m->func = args_get(args, 1);
 }
 
 static var Map_Iter_Init(var self) {
@@ -142,15 +142,15 @@ static void List_Rem(var self, var obj);
 static void List_New(var self, var args) {
   
   struct List* l = self;
-  l->type   = cast(get(args, $I(0)), Type);
+  l->type   = cast(args_get(args, 0), Type);
   l->tsize  = size(l->type);
   l->nitems = 0;
   l->head = NULL;
   l->tail = NULL;
   
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
   for(size_t i = 0; i < nargs-1; i++) {
-    List_Push(self, get(args, $I(i+1)));
+    List_Push(self, args_at(args, nargs, i+1));
   }
   
 }
@@ -26,8 +26,8 @@ static void Complex_New(var self, var args) {
     c->real = 0.0;
     c->imag = 0.0;
     
-    if (len(args) >= 1) c->real = c_float(get(args, $I(0)));
-    if (len(args) >= 2) c->imag = c_float(get(args, $I(1)));
+    if (args_len(args) >= 1) c->real = c_float(args_get(args, 0));
+    if (args_len(args) >= 2) c->imag = c_float(args_get(args, 1));
 }
 
 static void Complex_Del(var self) {
@@ -49,8 +49,8 @@ static void Vector2_New(var self, var args) {
     v->x = 0.0;
     v->y = 0.0;
     
-    if (len(args) >= 1) v->x = c_float(get(args, $I(0)));
-    if (len(args) >= 2) v->y = c_float(get(args, $I(1)));
+    if (args_len(args) >= 1) v->x = c_float(args_get(args, 0));
+    if (args_len(args) >= 2) v->y = c_float(args_get(args, 1));
 }
 
 static void Vector2_Del(var self) {
@@ -69,9 +69,9 @@ static void Vector3_New(var self, var args) {
     v->y = 0.0;
     v->z = 0.0;
     
-    if (len(args) >= 1) v->x = c_float(get(args, $I(0)));
-    if (len(args) >= 2) v->y = c_float(get(args, $I(1)));
-    if (len(args) >= 3) v->z = c_float(get(args, $I(2)));
+    if (args_len(args) >= 1) v->x = c_float(args_get(args, 0));
+    if (args_len(args) >= 2) v->y = c_float(args_get(args, 1));
+    if (args_len(args) >= 3) v->z = c_float(args_get(args, 2));
 }
 
 static void Vector3_Del(var self) {
@@ -90,9 +90,9 @@ static void Matrix_New(var self, var args) {
     m->cols = 0;
     m->data = NULL;
     
-    if (len(args) >= 2) {
-        m->rows = c_int(get(args, $I(0)));
-        m->cols = c_int(get(args, $I(1)));
+    if (args_len(args) >= 2) {
+        m->rows = c_int(args_get(args, 0));
+        m->cols = c_int(args_get(args, 1));
         m->data = calloc(m->rows * m->cols, sizeof(double));
     }
 }
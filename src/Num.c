@@ -162,6 +162,20 @@ static struct Example* Int_Examples(void) {
   
 }
 
+static struct Method* Int_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "new_int", 
+      "var new_int(int64_t val);",
+      "Construct a new `Int` from a native C value. This avoids the temporary "
+      "argument objects created by `new`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
 static void Int_Assign(var self, var obj) {
   struct Int* i = self;
   i->val = c_int(obj);
@@ -188,14 +202,26 @@ static int Int_Look(var self, var input, int pos) {
   return scan_from(input, pos, "%li", self);
 }
 
+static uint64_t Int_Layout(void) {
+  return 0;
+}
+
 var Int = Cello(Int,
   Instance(Doc,
-    Int_Name, Int_Brief, Int_Description, Int_Definition, Int_Examples, NULL),
+    Int_Name,       Int_Brief,    Int_Description,
+    Int_Definition, Int_Examples, Int_Methods),
   Instance(Assign,  Int_Assign),
   Instance(Cmp,     Int_Cmp),
   Instance(Hash,    Int_Hash),
   Instance(C_Int,   Int_C_Int),
-  Instance(Show,    Int_Show, Int_Look));
+  Instance(Show,    Int_Show, Int_Look),
+  Instance(Layout,  Int_Layout));
+
+var new_int(int64_t val) {
+  struct Int* i = alloc(Int);
+  i->val = val;
+  return i;
+}
 
 static const char* Float_Name(void) {
   return "Float";
@@ -235,6 +261,20 @@ static struct Example* Float_Examples(void) {
   
 }
 
+static struct Method* Float_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "new_float", 
+      "var new_float(double val);",
+      "Construct a new `Float` from a native C value. This avoids the temporary "
+      "argument objects created by `new`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
 static void Float_Assign(var self, var obj) {
   struct Float* f = self;
   f->val = c_float(obj);
@@ -269,12 +309,23 @@ int Float_Look(var self, var input, int pos) {
   return scan_from(input, pos, "%f", self);
 }
 
+static uint64_t Float_Layout(void) {
+  return 0;
+}
+
 var Float = Cello(Float,
   Instance(Doc,
     Float_Name,       Float_Brief,    Float_Description, 
-    Float_Definition, Float_Examples, NULL),
+    Float_Definition, Float_Examples, Float_Methods),
   Instance(Assign,  Float_Assign),
   Instance(Cmp,     Float_Cmp),
   Instance(Hash,    Float_Hash),
   Instance(C_Float, Float_C_Float),
-  Instance(Show,    Float_Show, Float_Look));
+  Instance(Show,    Float_Show, Float_Look),
+  Instance(Layout,  Float_Layout));
+
+var new_float(double val) {
+  struct Float* f = alloc(Float);
+  f->val = val;
+  return f;
+}
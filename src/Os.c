@@ -36,8 +36,8 @@ static void OSProcess_New(var self, var args) {
     p->stdout_pipe = NULL;
     p->stderr_pipe = NULL;
     
-    if (len(args) > 0) {
-        const char* command = c_str(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        const char* command = c_str(args_get(args, 0));
         p->command = malloc(strlen(command) + 1);
         strcpy(p->command, command);
     }
@@ -109,16 +109,16 @@ static void OSError_New(var self, var args) {
     err->message = NULL;
     err->function_name = NULL;
     
-    if (len(args) > 0) {
-        err->error_code = c_int(get(args, $I(0)));
+    if (args_len(args) > 0) {
+        err->error_code = c_int(args_get(args, 0));
     }
-    if (len(args) > 1) {
-        const char* msg = c_str(get(args, $I(1)));
+    if (args_len(args) > 1) {
+        const char* msg = c_str(args_get(args, 1));
         err->message = malloc(strlen(msg) + 1);
         strcpy(err->message, msg);
     }
-    if (len(args) > 2) {
-        const char* func = c_str(get(args, $I(2)));
+    if (args_len(args) > 2) {
+        const char* func = c_str(args_get(args, 2));
         err->function_name = malloc(strlen(func) + 1);
         strcpy(err->function_name, func);
     }
@@ -67,6 +67,9 @@ var Pointer = Cello(Pointer,
 
 void ref(var self, var item) {
   method(self, Pointer, ref, item);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
 }
 
 var deref(var self) {
@@ -231,7 +234,7 @@ static var Box_Deref(var self);
 static void Box_Assign(var self, var obj);
 
 static void Box_New(var self, var args) {
-  Box_Assign(self, get(args, $I(0)));
+  Box_Assign(self, args_get(args, 0));
 }
 
 static void Box_Del(var self) {
@@ -270,4 +273,93 @@ var Box = Cello(Box,
   Instance(Assign,   Box_Assign),
   Instance(Show,     Box_Show, NULL),
   Instance(Pointer,  Box_Ref, Box_Deref));
+
+static const char* Weak_Name(void) {
+  return "Weak";
+}
+
+static const char* Weak_Brief(void) {
+  return "Weak Pointer";
+}
+
+static const char* Weak_Description(void) {
+  return
+    "The `Weak` type is a wrapper around a C pointer which does not keep the "
+    "object it points to alive. Once the Garbage Collector finds that the "
+    "object is otherwise unreachable it is collected as usual and the `Weak` "
+    "is cleared to `NULL`. A `Weak` is cleared whether it was allocated with "
+    "`new` or is stored inside another collected object."
+    "\n\n"
+    "When `Weak` is used as the key type of a `Table` or `Tree` the "
+    "collection becomes an _ephemeron_ table. Each value is only kept alive "
+    "for as long as its key is, even if the value refers back to the key, "
+    "and entries are removed by the Garbage Collector once their key has "
+    "been collected. This makes it useful for caches and for attaching data "
+    "to objects without extending their lifetime. Ephemeron tables must be "
+    "allocated with `new` so that the Garbage Collector can find them.";
+}
+
+static const char* Weak_Definition(void) {
+  return
+    "struct Weak {\n"
+    "  var val;\n"
+    "};\n";
+}
+
+static struct Example* Weak_Examples(void) {
+  
+  static struct Example examples[] = {
+    {
+      "Usage",
+      "var w = new(Weak, new(String, $S(\"Hello\")));\n"
+      "show(deref(w)); /* Hello */\n"
+      "\n"
+      "gc_collect(current(GC));\n"
+      "show($I(deref(w) is NULL)); /* 1 */\n"
+    }, {
+      "Cache",
+      "var cache = new(Table, Weak, Ref);\n"
+      "var key = new(String, $S(\"Key\"));\n"
+      "set(cache, $W(key), $R(new(Int, $I(10))));\n"
+      "\n"
+      "show($I(len(cache))); /* 1 */\n"
+      "key = NULL;\n"
+      "gc_collect(current(GC));\n"
+      "show($I(len(cache))); /* 0 */\n"
+    }, {NULL, NULL}
+  };
+
+  return examples;
   
+}
+
+static void Weak_Ref(var self, var val) {
+  struct Weak* w = self;
+  w->val = val;
+}
+
+static var Weak_Deref(var self) {
+  struct Weak* w = self;
+  return w->val;
+}
+
+static void Weak_Assign(var self, var obj) {
+  struct Pointer* p = instance(obj, Pointer);
+  if (p and p->deref) {
+    Weak_Ref(self, p->deref(obj));
+  } else {
+    Weak_Ref(self, obj);
+  }
+}
+
+static uint64_t Weak_Layout(void) {
+  return 0;
+}
+
+var Weak = Cello(Weak,
+  Instance(Doc,
+    Weak_Name, Weak_Brief, Weak_Description, Weak_Definition, Weak_Examples, 
+    NULL),
+  Instance(Assign,   Weak_Assign),
+  Instance(Layout,   Weak_Layout),
+  Instance(Pointer,  Weak_Ref, Weak_Deref));
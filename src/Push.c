@@ -83,7 +83,19 @@ var Push = Cello(Push,
     Push_Name,       Push_Brief,    Push_Description, 
     Push_Definition, Push_Examples, Push_Methods));
 
-void push(var self, var val) { method(self, Push, push, val); }
-void push_at(var self, var val, var i) { method(self, Push, push_at, val, i); }
+void push(var self, var val) {
+  method(self, Push, push, val);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
+}
+
+void push_at(var self, var val, var i) {
+  method(self, Push, push_at, val, i);
+#ifndef CELLO_NGC
+  gc_barrier(self);
+#endif
+}
+
 void pop(var self) { method(self, Push, pop); }
 void pop_at(var self, var i) { method(self, Push, pop_at, i); }
@@ -247,6 +247,7 @@ int print_to_with(var out, int pos, const char* fmt, var args) {
   
   char* fmt_buf = malloc(strlen(fmt)+1); 
   size_t index = 0;
+  size_t nargs = args_len(args);
   
   while (true) {
     
@@ -283,11 +284,11 @@ int print_to_with(var out, int pos, const char* fmt, var args) {
       memcpy(fmt_buf, start, fmt - start + 1);
       fmt_buf[fmt - start + 1] = '\0';
       
-      if (index >= len(args)) {
+      if (index >= nargs) {
         throw(FormatError, "Not enough arguments to Format String!");
       }
       
-      var a = get(args, $I(index)); index++;
+      var a = args_at(args, nargs, index); index++;
       
       if (*fmt is '$') { pos = show_to(a, out, pos); }
       
@@ -357,6 +358,7 @@ int scan_from_with(var input, int pos, const char* fmt, var args) {
   
   char* fmt_buf = malloc(strlen(fmt)+4);
   size_t index = 0;
+  size_t nargs = args_len(args);
   
   while (true) {
     
@@ -394,11 +396,11 @@ int scan_from_with(var input, int pos, const char* fmt, var args) {
       fmt_buf[fmt - start + 1] = '\0';
       strcat(fmt_buf, "%n");
 
-      if (index >= len(args)) {
+      if (index >= nargs) {
         throw(FormatError, "Not enough arguments to Format String!");
       }
       
-      var a = get(args, $I(index)); index++;
+      var a = args_at(args, nargs, index); index++;
       
       if (*fmt is '$') { pos = look_from(a, input, pos); }
       
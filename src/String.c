@@ -121,12 +121,26 @@ static struct Example* String_Examples(void) {
   
 }
 
+static struct Method* String_Methods(void) {
+  
+  static struct Method methods[] = {
+    {
+      "new_str", 
+      "var new_str(const char* val);",
+      "Construct a new `String` holding a copy of the C string `val`. This "
+      "avoids the temporary argument objects created by `new`."
+    }, {NULL, NULL, NULL}
+  };
+  
+  return methods;
+}
+
 static void String_Assign(var self, var obj);
 
 static void String_New(var self, var args) {
   struct String* s = self;
-  if (len(args) > 0) {
-    String_Assign(self, get(args, $I(0)));
+  if (args_len(args) > 0) {
+    String_Assign(self, args_get(args, 0));
   } else {
     s->val = calloc(1, 1);
   }
@@ -443,11 +457,16 @@ static int String_Look(var self, var input, int pos) {
   return pos;
 }
 
+static uint64_t String_Layout(void) {
+  return 0;
+}
+
 var String = Cello(String,
   Instance(Doc,
     String_Name,       String_Brief,    String_Description,
-    String_Definition, String_Examples, NULL),
+    String_Definition, String_Examples, String_Methods),
   Instance(New,     String_New, String_Del),
+  Instance(Finalize, String_Del),
   Instance(Assign,  String_Assign),
   Instance(Cmp,     String_Cmp),
   Instance(Hash,    String_Hash),
@@ -457,5 +476,22 @@ var String = Cello(String,
   Instance(Concat,  String_Concat, String_Concat),
   Instance(C_Str,   String_C_Str),
   Instance(Format,  String_Format_To, String_Format_From),
-  Instance(Show,    String_Show, String_Look));
+  Instance(Show,    String_Show, String_Look),
+  Instance(Layout,  String_Layout));
+
+var new_str(const char* val) {
+  
+  struct String* s = alloc(String);
+  size_t n = strlen(val);
+  s->val = malloc(n + 1);
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (s->val is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate String, out of memory!");
+  }
+#endif
+  
+  memcpy(s->val, val, n + 1);
+  return s;
+}
 
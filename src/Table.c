@@ -1,5 +1,9 @@
 #include "Cello.h"
 
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+
 static const char* Table_Name(void) {
   return "Table";
 }
@@ -11,13 +15,18 @@ static const char* Table_Brief(void) {
 static const char* Table_Description(void) {
   return
     "The `Table` type is a hash table data structure that maps keys to values. "
-    "It uses an open-addressing robin-hood hashing scheme which requires "
-    "`Hash` and `Cmp` to be defined on the key type. Keys and values are "
-    "copied into the collection using the `Assign` class and intially have "
-    "zero'd memory."
+    "It uses an open-addressing scheme which requires `Hash` and `Cmp` to be "
+    "defined on the key type. Keys and values are copied into the collection "
+    "using the `Assign` class and intially have zero'd memory."
     "\n\n"
-    "Hash tables provide `O(1)` lookup, insertion and removal can but require "
-    "long pauses when the table must be _rehashed_ and all entries processed."
+    "Alongside the slots a `Table` keeps one control byte per slot holding "
+    "a fragment of the key hash. Lookups compare these sixteen at a time "
+    "and only call `eq` on slots whose fragment matches."
+    "\n\n"
+    "Hash tables provide `O(1)` lookup, insertion and removal. When a `Table` "
+    "grows or shrinks its entries are moved into the new slots a few at a "
+    "time by later insertions and removals, so no single operation has to "
+    "_rehash_ every entry."
     "\n\n"
     "This is largely equivalent to the C++ construct "
     "[std::unordered_map](http://www.cplusplus.com/reference/unordered_map/unordered_map/)";
@@ -65,78 +74,264 @@ static struct Example* Table_Examples(void) {
 }
 
 struct Table {
-  var data;
+  uint8_t* ctrl;
+  uint32_t* hashes;
+  var keys;
+  var vals;
   var ktype;
   var vtype;
   size_t ksize;
   size_t vsize;
   size_t nslots;
   size_t nitems;
-  var sspace0;
-  var sspace1;
+  size_t ndeleted;
+  struct Table* old;
+  size_t nmoved;
 };
 
+/*
+**  Tables are always a power of two in size, so that finding
+**  a slot is a mask rather than a division. Because this only
+**  uses the low bits of the hash, and many hash functions such
+**  as the one for `Int` are weak, every key hash is first put
+**  through `hash_mix`. The home slot is picked from the low 32
+**  bits of the result, which are also the bits kept per slot,
+**  and the control byte fragment is the top seven bits, so the
+**  two never overlap however large the table grows.
+*/
+
+static uint64_t Table_Key_Hash(var key) {
+  return hash_mix(hash(key));
+}
+
+static size_t Table_Ideal_Size(size_t size) {
+  size_t need = ((size+1) * 8 + 6) / 7;
+  size_t nslots = 1;
+  while (nslots < need) { nslots *= 2; }
+  return nslots;
+}
+
+/*
+**  Slots are split over four parallel arrays. The control bytes
+**  and the key hashes are dense, so probing only touches five
+**  bytes per slot, and the keys are only looked at once their
+**  hash matches. Values are kept apart again so they are only
+**  read when returned. Keys and values still carry a `Header`
+**  each because references to them are handed out by `get` and
+**  by iteration, and must be usable as normal objects.
+**
+**  A slot therefore costs `5 + 2 * sizeof(struct Header)` bytes
+**  plus the key and value sizes, which for `Int` to `Int` without
+**  debug headers is 37 bytes.
+*/
+
+static size_t Table_Key_Step(struct Table* t) {
+  return sizeof(struct Header) + t->ksize;
+}
+
+static size_t Table_Val_Step(struct Table* t) {
+  return sizeof(struct Header) + t->vsize;
+}
+
+static uint64_t Table_Index(struct Table* t, var key) {
+  return ((char*)key - (char*)t->keys) / Table_Key_Step(t);
+}
+
+static bool Table_Owns(struct Table* t, var key) {
+  return key >= t->keys
+    and (char*)key < (char*)t->keys + t->nslots * Table_Key_Step(t);
+}
+
+static var Table_Key(struct Table* t, uint64_t i) {
+  return (char*)t->keys + i * Table_Key_Step(t) + sizeof(struct Header);
+}
+
+static var Table_Val(struct Table* t, uint64_t i) {
+  return (char*)t->vals + i * Table_Val_Step(t) + sizeof(struct Header);
+}
+
+/*
+**  Every slot has a control byte which is either `TABLE_EMPTY`,
+**  `TABLE_DELETED`, or for a full slot a seven bit fragment of
+**  the key hash. Probing starts at the home slot and looks at
+**  sixteen control bytes at a time, matching the fragment for
+**  all of them at once, and stops at the first group which has
+**  an empty slot.
+**
+**  So that a group can start at any slot, the first sixteen
+**  control bytes are mirrored after the end of the array. For
+**  tables with fewer than sixteen slots the mirror just wraps
+**  around several times.
+*/
+
 enum {
-  TABLE_PRIMES_COUNT = 24
+  TABLE_GROUP   = 16,
+  TABLE_EMPTY   = 0x80,
+  TABLE_DELETED = 0xFE
 };
 
-static const size_t Table_Primes[TABLE_PRIMES_COUNT] = {
-  0,       1,       5,       11,
-  23,      53,      101,     197,
-  389,     683,     1259,    2417,
-  4733,    9371,    18617,   37097,
-  74093,   148073,  296099,  592019,
-  1100009, 2200013, 4400021, 8800019
-};
+static uint8_t Table_Fragment(uint64_t h) {
+  return (uint8_t)(h >> 57);
+}
 
-static const double Table_Load_Factor = 0.9;
+static uint32_t Table_Match(const uint8_t* ctrl, uint8_t c) {
+#if defined __SSE2__
+  __m128i g = _mm_loadu_si128((const __m128i*)ctrl);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)c)));
+#else
+  uint32_t m = 0;
+  for (size_t k = 0; k < TABLE_GROUP; k++) {
+    m |= (uint32_t)(ctrl[k] is c) << k;
+  }
+  return m;
+#endif
+}
 
-static size_t Table_Ideal_Size(size_t size) {
-  size = (size_t)((double)(size+1) / Table_Load_Factor);
-  for (size_t i = 0; i < TABLE_PRIMES_COUNT; i++) {
-    if (Table_Primes[i] >= size) { return Table_Primes[i]; }
+static uint32_t Table_Match_Free(const uint8_t* ctrl) {
+#if defined __SSE2__
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+  uint32_t m = 0;
+  for (size_t k = 0; k < TABLE_GROUP; k++) {
+    m |= (uint32_t)(ctrl[k] >> 7) << k;
   }
-  size_t last = Table_Primes[TABLE_PRIMES_COUNT-1];
-  for (size_t i = 0;; i++) {
-    if (last * i >= size) { return last * i; }
+  return m;
+#endif
+}
+
+static size_t Table_Bit(uint32_t m) {
+#if defined __GNUC__ || defined __clang__
+  return (size_t)__builtin_ctz(m);
+#else
+  size_t b = 0;
+  while (not (m & 1)) { m >>= 1; b++; }
+  return b;
+#endif
+}
+
+static uint64_t Table_Slot(struct Table* t, uint64_t i, size_t k) {
+  return (i + k) & (t->nslots - 1);
+}
+
+static bool Table_Full(struct Table* t, uint64_t i) {
+  return t->ctrl[i] < TABLE_EMPTY;
+}
+
+static void Table_Ctrl_Set(struct Table* t, uint64_t i, uint8_t c) {
+  t->ctrl[i] = c;
+  for (size_t j = i + t->nslots; j < t->nslots + TABLE_GROUP; j += t->nslots) {
+    t->ctrl[j] = c;
   }
 }
 
-static size_t Table_Step(struct Table* t) {
-  return
-    sizeof(uint64_t) + 
-    sizeof(struct Header) + t->ksize + 
-    sizeof(struct Header) + t->vsize;
+static bool Table_Find(struct Table* t, var key, uint64_t h, uint64_t* slot) {
+  
+  uint8_t c = Table_Fragment(h);
+  uint64_t i = (uint32_t)h & (t->nslots - 1);
+  CELLO_PREFETCH(&t->hashes[i]);
+  CELLO_PREFETCH(Table_Key(t, i));
+  
+  for (size_t n = 0; n < t->nslots; n += TABLE_GROUP) {
+    
+    uint32_t m = Table_Match(t->ctrl + i, c);
+    while (m) {
+      uint64_t s = Table_Slot(t, i, Table_Bit(m));
+      if (t->hashes[s] is (uint32_t)h and eq(Table_Key(t, s), key)) {
+        *slot = s;
+        return true;
+      }
+      m &= m - 1;
+    }
+    
+    if (Table_Match(t->ctrl + i, TABLE_EMPTY)) { return false; }
+    i = Table_Slot(t, i, TABLE_GROUP);
+  }
+  
+  return false;
 }
 
-static uint64_t Table_Key_Hash(struct Table* t, uint64_t i) {
-  return *(uint64_t*)((char*)t->data + i * Table_Step(t));
+static uint64_t Table_Free(struct Table* t, uint32_t h) {
+  uint64_t i = h & (t->nslots - 1);
+  while (true) {
+    uint32_t m = Table_Match_Free(t->ctrl + i);
+    if (m) { return Table_Slot(t, i, Table_Bit(m)); }
+    i = Table_Slot(t, i, TABLE_GROUP);
+  }
 }
 
-static var Table_Key(struct Table* t, uint64_t i) {
-  return (char*)t->data + i * Table_Step(t) +
-    sizeof(uint64_t) + 
-    sizeof(struct Header);  
+/*
+**  A removed slot can only be marked empty again if every
+**  group containing it already has some other empty slot,
+**  otherwise a probe which used to continue past this
+**  group would stop early. This is the case when the full
+**  slots either side of it sum to less than a group.
+*/
+
+static uint8_t Table_Tombstone(struct Table* t, uint64_t i) {
+  
+  size_t after = 0, before = 0;
+  while (after < TABLE_GROUP
+  and t->ctrl[Table_Slot(t, i, after+1)] isnt TABLE_EMPTY) { after++; }
+  while (before < TABLE_GROUP
+  and t->ctrl[(i - (before+1)) & (t->nslots - 1)]
+  isnt TABLE_EMPTY) { before++; }
+  
+  return after + before < TABLE_GROUP - 1 ? TABLE_EMPTY : TABLE_DELETED;
 }
 
-static var Table_Val(struct Table* t, uint64_t i) {
-  return (char*)t->data + i * Table_Step(t) +
-    sizeof(uint64_t) + 
-    sizeof(struct Header) + 
-    t->ksize + 
-    sizeof(struct Header);  
+static void Table_Alloc(struct Table* t) {
+  
+  t->ctrl = malloc(t->nslots + TABLE_GROUP);
+  t->hashes = malloc(t->nslots * sizeof(uint32_t));
+  t->keys = malloc(t->nslots * Table_Key_Step(t));
+  t->vals = malloc(t->nslots * Table_Val_Step(t));
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (t->ctrl is NULL or t->hashes is NULL
+  or  t->keys is NULL or t->vals is NULL) {
+    throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
+  }
+#endif
+  
+  memset(t->ctrl, TABLE_EMPTY, t->nslots + TABLE_GROUP);
+  t->ndeleted = 0;
 }
 
-static uint64_t Table_Probe(struct Table* t, uint64_t i, uint64_t h) {
-  int64_t v = i - (h-1);
-  if (v < 0) {
-    v = t->nslots + v;
+static void Table_Dealloc(struct Table* t) {
+  free(t->ctrl);
+  free(t->hashes);
+  free(t->keys);
+  free(t->vals);
+  t->ctrl = NULL;
+  t->hashes = NULL;
+  t->keys = NULL;
+  t->vals = NULL;
+}
+
+static void Table_Drop(struct Table* t) {
+  
+  for (struct Table* s = t; s isnt NULL; s = s->old) {
+    for (size_t i = 0; i < s->nslots; i++) {
+      if (Table_Full(s, i)) {
+        destruct(Table_Key(s, i));
+        destruct(Table_Val(s, i));
+      }
+    }
+  }
+  
+  if (t->old isnt NULL) {
+    Table_Dealloc(t->old);
+    free(t->old);
+    t->old = NULL;
   }
-  return v;
+  
+  Table_Dealloc(t);
+  
 }
 
 static void Table_Set(var self, var key, var val);
-static void Table_Set_Move(var self, var key, var val, bool move);
+static void Table_Insert(struct Table* t, var key, var val);
+static void Table_Rehash(struct Table* t, size_t new_size);
 
 static size_t Table_Size_Round(size_t s) {
   return ((s + sizeof(var) - 1) / sizeof(var)) * sizeof(var);
@@ -145,12 +340,12 @@ static size_t Table_Size_Round(size_t s) {
 static void Table_New(var self, var args) {
   
   struct Table* t = self;
-  t->ktype = cast(get(args, $(Int, 0)), Type);
-  t->vtype = cast(get(args, $(Int, 1)), Type);
+  t->ktype = cast(args_get(args, 0), Type);
+  t->vtype = cast(args_get(args, 1), Type);
   t->ksize = Table_Size_Round(size(t->ktype));
   t->vsize = Table_Size_Round(size(t->vtype));
   
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
   if (nargs % 2 isnt 0) {
     throw(FormatError, 
       "Received non multiple of two argument count to Table constructor.");
@@ -158,44 +353,22 @@ static void Table_New(var self, var args) {
   
   t->nslots = Table_Ideal_Size((nargs-2)/2);
   t->nitems = 0;
+  t->ndeleted = 0;
+  t->old = NULL;
+  t->nmoved = 0;
   
-  if (t->nslots is 0) {
-    t->data = NULL;
-    return;
-  }
-  
-  t->data = calloc(t->nslots, Table_Step(t));
-  t->sspace0 = calloc(1, Table_Step(t));
-  t->sspace1 = calloc(1, Table_Step(t));
-  
-#if CELLO_MEMORY_CHECK == 1
-  if (t->data is NULL or t->sspace0 is NULL or t->sspace1 is NULL) {
-    throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
-  }
-#endif
+  Table_Alloc(t);
   
   for(size_t i = 0; i < (nargs-2)/2; i++) {
-    var key = get(args, $(Int, 2+(i*2)+0));
-    var val = get(args, $(Int, 2+(i*2)+1));
-    Table_Set_Move(t, key, val, false);
+    var key = args_at(args, nargs, 2+(i*2)+0);
+    var val = args_at(args, nargs, 2+(i*2)+1);
+    Table_Insert(t, key, val);
   }
   
 }
 
 static void Table_Del(var self) {
-  struct Table* t = self;  
-  
-  for (size_t i = 0; i < t->nslots; i++) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-    }
-  }
-  
-  free(t->data);
-  free(t->sspace0);
-  free(t->sspace1);
-  
+  Table_Drop(self);
 }
 
 static var Table_Key_Type(var self) {
@@ -211,18 +384,11 @@ static var Table_Val_Type(var self) {
 static void Table_Clear(var self) {
   struct Table* t = self;
   
-  for (size_t i = 0; i < t->nslots; i++) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-    }
-  }
-  
-  free(t->data);
+  Table_Drop(t);
   
   t->nslots = 0;
   t->nitems = 0;
-  t->data = NULL;
+  t->ndeleted = 0;
   
 }
 
@@ -237,26 +403,10 @@ static void Table_Assign(var self, var obj) {
   t->nitems = 0;
   t->nslots = Table_Ideal_Size(len(obj));
   
-  if (t->nslots is 0) {
-    t->data = NULL;
-    return;
-  }
-  
-  t->data = calloc(t->nslots, Table_Step(t));
-  t->sspace0 = realloc(t->sspace0, Table_Step(t));
-  t->sspace1 = realloc(t->sspace1, Table_Step(t));
-  
-#if CELLO_MEMORY_CHECK == 1
-  if (t->data is NULL or t->sspace0 is NULL or t->sspace1 is NULL) {
-    throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
-  }
-#endif
-
-  memset(t->sspace0, 0, Table_Step(t));
-  memset(t->sspace1, 0, Table_Step(t));
+  Table_Alloc(t);
   
   foreach(key in obj) {
-    Table_Set_Move(t, key, get(obj, key), false);
+    Table_Insert(t, key, get(obj, key));
   }
   
 }
@@ -292,12 +442,11 @@ static int Table_Cmp(var self, var obj) {
 }
 
 static uint64_t Table_Hash(var self) {
-  struct Table* t = self;
   uint64_t h = 0;
   
   var curr = Table_Iter_Init(self);
   while (curr isnt Terminal) {
-    var vurr = (char*)curr + t->ksize + sizeof(struct Header);
+    var vurr = Table_Get(self, curr);
     h = h ^ hash(curr) ^ hash(vurr);
     curr = Table_Iter_Next(self, curr);
   }
@@ -310,314 +459,311 @@ static size_t Table_Len(var self) {
   return t->nitems;
 }
 
-static uint64_t Table_Swapspace_Hash(struct Table* t, var space) {
-  return *((uint64_t*)space);
-}
+/*
+**  While a `Table` is being resized the entries not yet moved
+**  live in `old`, so a key may be found in either set of slots.
+*/
 
-static var Table_Swapspace_Key(struct Table* t, var space) {
-  return (char*)space + sizeof(uint64_t) + sizeof(struct Header);
+static struct Table* Table_Locate(
+  struct Table* t, var key, uint64_t h, uint64_t* slot) {
+  
+  if (t->nslots is 0) { return NULL; }
+  if (Table_Find(t, key, h, slot)) { return t; }
+  if (t->old isnt NULL and Table_Find(t->old, key, h, slot)) { return t->old; }
+  return NULL;
 }
 
-static var Table_Swapspace_Val(struct Table* t, var space) {
-  return (char*)space + sizeof(uint64_t) + sizeof(struct Header) +
-    t->ksize + sizeof(struct Header); 
-}
+/*
+**  New entries are assigned straight into their slot. An existing
+**  key is kept and only its value is assigned over, so that setting
+**  a key or value which is itself a reference into the table is safe.
+*/
 
-static void Table_Set_Move(var self, var key, var val, bool move) {
+static void Table_Insert(struct Table* t, var key, var val) {
   
-  struct Table* t = self;
   key = cast(key, t->ktype);
   val = cast(val, t->vtype);
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
-  
-  memset(t->sspace0, 0, Table_Step(t));
-  memset(t->sspace1, 0, Table_Step(t));
+  if (t->nslots is 0) { Table_Rehash(t, Table_Ideal_Size(1)); }
   
-  if (move) {
-      
-    uint64_t ihash = i+1;
-    memcpy((char*)t->sspace0, &ihash, sizeof(uint64_t));
-    memcpy((char*)t->sspace0 + sizeof(uint64_t),
-      (char*)key - sizeof(struct Header),
-      t->ksize + sizeof(struct Header));
-    memcpy((char*)t->sspace0 + sizeof(uint64_t) +
-      sizeof(struct Header) + t->ksize, 
-      (char*)val - sizeof(struct Header),
-      t->vsize + sizeof(struct Header));
+  uint64_t h = Table_Key_Hash(key);
+  uint64_t i;
   
-  } else {
-        
-    struct Header* khead = (struct Header*)
-      ((char*)t->sspace0 + sizeof(uint64_t));
-    struct Header* vhead = (struct Header*)
-      ((char*)t->sspace0 + sizeof(uint64_t) 
-      + sizeof(struct Header) + t->ksize);
-    
-    header_init(khead, t->ktype, AllocData);
-    header_init(vhead, t->vtype, AllocData);
-    
-    uint64_t ihash = i+1;
-    memcpy((char*)t->sspace0, &ihash, sizeof(uint64_t)); 
-    assign((char*)t->sspace0 + sizeof(uint64_t) + sizeof(struct Header), key);
-    assign((char*)t->sspace0 + sizeof(uint64_t) + sizeof(struct Header)
-      + t->ksize + sizeof(struct Header), val);
+  struct Table* s = Table_Locate(t, key, h, &i);
+  if (s isnt NULL) {
+    if (Table_Val(s, i) isnt val) { assign(Table_Val(s, i), val); }
+    return;
   }
   
-  while (true) {
-    
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0) {
-      memcpy((char*)t->data + i * Table_Step(t), t->sspace0, Table_Step(t));
-      t->nitems++;
-      return;
-    }
-    
-    if (eq(Table_Key(t, i), Table_Swapspace_Key(t, t->sspace0))) {
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-      memcpy((char*)t->data + i * Table_Step(t), t->sspace0, Table_Step(t));
-      return;
-    }
-    
-    uint64_t p = Table_Probe(t, i, h);
-    if (j >= p) {
-      memcpy((char*)t->sspace1, (char*)t->data + i * Table_Step(t), Table_Step(t));
-      memcpy((char*)t->data + i * Table_Step(t), (char*)t->sspace0, Table_Step(t));
-      memcpy((char*)t->sspace0, (char*)t->sspace1, Table_Step(t));
-      j = p;
+  i = Table_Free(t, (uint32_t)h);
+  
+  var k = Table_Key(t, i);
+  var v = Table_Val(t, i);
+  memset((char*)k - sizeof(struct Header), 0, Table_Key_Step(t));
+  memset((char*)v - sizeof(struct Header), 0, Table_Val_Step(t));
+  header_init((char*)k - sizeof(struct Header), t->ktype, AllocData);
+  header_init((char*)v - sizeof(struct Header), t->vtype, AllocData);
+  assign(k, key);
+  assign(v, val);
+  
+  if (t->ctrl[i] is TABLE_DELETED) { t->ndeleted--; }
+  t->hashes[i] = (uint32_t)h;
+  Table_Ctrl_Set(t, i, Table_Fragment(h));
+  t->nitems++;
+  
+}
+
+/*
+**  Because every slot keeps the hash of its key, and its
+**  fragment in the control byte, moving an entry into a new
+**  set of slots never has to call `hash` again and is just a
+**  couple of memory moves.
+*/
+
+static void Table_Move(struct Table* t, struct Table* src, uint64_t i) {
+  uint32_t h = src->hashes[i];
+  uint64_t j = Table_Free(t, h);
+  memcpy((char*)Table_Key(t, j) - sizeof(struct Header),
+    (char*)Table_Key(src, i) - sizeof(struct Header), Table_Key_Step(t));
+  memcpy((char*)Table_Val(t, j) - sizeof(struct Header),
+    (char*)Table_Val(src, i) - sizeof(struct Header), Table_Val_Step(t));
+  if (t->ctrl[j] is TABLE_DELETED) { t->ndeleted--; }
+  t->hashes[j] = h;
+  Table_Ctrl_Set(t, j, src->ctrl[i]);
+}
+
+/*
+**  Growing or shrinking a `Table` allocates the new slots and
+**  keeps the old ones around in `old`. Every following `set`
+**  and `rem` then moves the entries out of the next
+**  `TABLE_MIGRATE` old slots, marking them deleted, until none
+**  are left. This spreads the cost of a rehash evenly rather
+**  than stalling a single insertion on a large table. Lookups
+**  never move entries, so the references they return stay
+**  valid until the table is next modified.
+*/
+
+enum {
+  TABLE_MIGRATE = 256
+};
+
+static void Table_Migrate_Step(struct Table* t) {
+  
+  struct Table* old = t->old;
+  if (old is NULL) { return; }
+  
+  size_t end = t->nmoved + TABLE_MIGRATE;
+  if (end > old->nslots) { end = old->nslots; }
+  
+  for (; t->nmoved < end and old->nitems > 0; t->nmoved++) {
+    if (Table_Full(old, t->nmoved)) {
+      Table_Move(t, old, t->nmoved);
+      Table_Ctrl_Set(old, t->nmoved, TABLE_DELETED);
+      old->nitems--;
     }
-    
-    i = (i+1) % t->nslots;
-    j++;
+  }
+  
+  if (t->nmoved is old->nslots or old->nitems is 0) {
+    Table_Dealloc(old);
+    free(old);
+    t->old = NULL;
   }
   
 }
 
-static void Table_Rehash(struct Table* t, size_t new_size) {
+static void Table_Migrate_Finish(struct Table* t) {
+  while (t->old isnt NULL) { Table_Migrate_Step(t); }
+}
+
+static void Table_Migrate_Start(struct Table* t, size_t new_size) {
   
-  var old_data = t->data;
-  size_t old_size = t->nslots;
+  Table_Migrate_Finish(t);
   
-  t->nslots = new_size;
-  t->nitems = 0;
-  t->data = calloc(t->nslots, Table_Step(t));
+  struct Table* old = malloc(sizeof(struct Table));
   
 #if CELLO_MEMORY_CHECK == 1
-  if (t->data is NULL) {
+  if (old is NULL) {
     throw(OutOfMemoryError, "Cannot allocate Table, out of memory!");
   }
 #endif
   
-  for (size_t i = 0; i < old_size; i++) {
-    
-    uint64_t h = *(uint64_t*)((char*)old_data + i * Table_Step(t));
-    
-    if (h isnt 0) {
-      var key = (char*)old_data + i * Table_Step(t) +
-        sizeof(uint64_t) + sizeof(struct Header);
-      var val = (char*)old_data + i * Table_Step(t) +
-        sizeof(uint64_t) + sizeof(struct Header) + 
-        t->ksize + sizeof(struct Header);
-      Table_Set_Move(t, key, val, true);
-    }
-    
+  *old = *t;
+  t->old = old;
+  t->nmoved = 0;
+  t->nslots = new_size;
+  Table_Alloc(t);
+  
+}
+
+static void Table_Rehash(struct Table* t, size_t new_size) {
+  
+  Table_Migrate_Finish(t);
+  
+  struct Table old = *t;
+  t->nslots = new_size;
+  Table_Alloc(t);
+  
+  for (size_t i = 0; i < old.nslots; i++) {
+    if (Table_Full(&old, i)) { Table_Move(t, &old, i); }
   }
   
-  free(old_data);
+  Table_Dealloc(&old);
 }
 
 static void Table_Resize_More(struct Table* t) {
   size_t new_size = Table_Ideal_Size(t->nitems);  
   size_t old_size = t->nslots;
-  if (new_size > old_size) { Table_Rehash(t, new_size); }
+  if (new_size > old_size
+  or  Table_Ideal_Size(t->nitems + t->ndeleted) > old_size) {
+    Table_Migrate_Start(t, new_size);
+  }
 }
 
+/*
+**  Shrinking waits until the table is a quarter full and then
+**  only halves it, so alternating `set` and `rem` around a size
+**  boundary cannot make it resize back and forth.
+*/
+
 static void Table_Resize_Less(struct Table* t) {
+  if (t->old isnt NULL) { return; }
   size_t new_size = Table_Ideal_Size(t->nitems);  
-  size_t old_size = t->nslots;
-  if (new_size < old_size) { Table_Rehash(t, new_size); }
+  if (new_size * 4 <= t->nslots) { Table_Migrate_Start(t, new_size * 2); }
 }
 
 static bool Table_Mem(var self, var key) {
   struct Table* t = self;
   key = cast(key, t->ktype);
   
-  if (t->nslots is 0) { return false; }
-  
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
-  
-  while (true) {
-    
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      return false;
-    }
-    
-    if (eq(Table_Key(t, i), key)) {
-      return true;
-    }
-    
-    i = (i+1) % t->nslots; j++;
-  }
-  
-  return false;
+  uint64_t i;
+  return Table_Locate(t, key, Table_Key_Hash(key), &i) isnt NULL;
 }
 
 static void Table_Rem(var self, var key) {
   struct Table* t = self;
   key = cast(key, t->ktype);
   
-  if (t->nslots is 0) {
+  uint64_t i;
+  struct Table* s = Table_Locate(t, key, Table_Key_Hash(key), &i);
+  if (s is NULL) {
     throw(KeyError, "Key %$ not in Table!", key);
   }
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
+  destruct(Table_Key(s, i));
+  destruct(Table_Val(s, i));
   
-  while (true) {
-    
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      throw(KeyError, "Key %$ not in Table!", key);
-    }
-    
-    if (eq(Table_Key(t, i), key)) {
-      
-      destruct(Table_Key(t, i));
-      destruct(Table_Val(t, i));
-      memset((char*)t->data + i * Table_Step(t), 0, Table_Step(t));
-      
-      while (true) {
-        
-        uint64_t ni = (i+1) % t->nslots;
-        uint64_t nh = Table_Key_Hash(t, ni);
-        if (nh isnt 0 and Table_Probe(t, ni, nh) > 0) {
-          memcpy(
-            (char*)t->data + i * Table_Step(t),
-            (char*)t->data + ni * Table_Step(t),
-            Table_Step(t));
-          memset((char*)t->data + ni * Table_Step(t), 0, Table_Step(t));
-          i = ni;
-        } else {
-          break;
-        }
-        
-      }
-      
-      t->nitems--;
-      Table_Resize_Less(t);
-      return;
-    }
-    
-    i = (i+1) % t->nslots; j++;
+  if (s is t) {
+    uint8_t c = Table_Tombstone(t, i);
+    if (c is TABLE_DELETED) { t->ndeleted++; }
+    Table_Ctrl_Set(t, i, c);
+  } else {
+    Table_Ctrl_Set(s, i, TABLE_DELETED);
+    s->nitems--;
   }
   
+  t->nitems--;
+  Table_Resize_Less(t);
+  Table_Migrate_Step(t);
+  
 }
 
 static var Table_Get(var self, var key) {
   struct Table* t = self;
   
-  if (key >= t->data and ((char*)key) < ((char*)t->data) + t->nslots * Table_Step(self)) {
-    return Table_Val(self, (((char*)key) - ((char*)t->data)) / Table_Step(self));
+  if (Table_Owns(t, key)) {
+    return Table_Val(t, Table_Index(t, key));
   }
   
-  key = cast(key, t->ktype);
-  
-  if (t->nslots is 0) {
-    throw(KeyError, "Key %$ not in Table!", key);
+  if (t->old isnt NULL and Table_Owns(t->old, key)) {
+    return Table_Val(t->old, Table_Index(t->old, key));
   }
   
-  uint64_t i = hash(key) % t->nslots;
-  uint64_t j = 0;
+  key = cast(key, t->ktype);
   
-  while (true) {
-
-    uint64_t h = Table_Key_Hash(t, i);
-    if (h is 0 or j > Table_Probe(t, i, h)) {
-      throw(KeyError, "Key %$ not in Table!", key);
-    }
-    
-    if (eq(Table_Key(t, i), key)) {
-      return Table_Val(t, i);
-    }
-    
-    i = (i+1) % t->nslots; j++;
+  uint64_t i;
+  struct Table* s = Table_Locate(t, key, Table_Key_Hash(key), &i);
+  if (s is NULL) {
+    throw(KeyError, "Key %$ not in Table!", key);
   }
   
-  return NULL;
+  return Table_Val(s, i);
 }
 
 static void Table_Set(var self, var key, var val) {
-  Table_Set_Move(self, key, val, false);
+  Table_Insert(self, key, val);
   Table_Resize_More(self);
+  Table_Migrate_Step(self);
+}
+
+/*
+**  Iteration visits the current slots first and then any
+**  entries still waiting to be moved out of `old`.
+*/
+
+static var Table_Scan(struct Table* t, size_t i) {
+  for (; i < t->nslots; i++) {
+    if (Table_Full(t, i)) { return Table_Key(t, i); }
+  }
+  return Terminal;
+}
+
+static var Table_Scan_Back(struct Table* t, size_t i) {
+  while (i > 0) {
+    i--;
+    if (Table_Full(t, i)) { return Table_Key(t, i); }
+  }
+  return Terminal;
 }
 
 static var Table_Iter_Init(var self) {
   struct Table* t = self;
   if (t->nitems is 0) { return Terminal; }
   
-  for (size_t i = 0; i < t->nslots; i++) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      return Table_Key(t, i);
-    }
+  var curr = Table_Scan(t, 0);
+  if (curr is Terminal and t->old isnt NULL) {
+    curr = Table_Scan(t->old, 0);
   }
   
-  return Terminal;
+  return curr;
 }
 
 static var Table_Iter_Next(var self, var curr) {
   struct Table* t = self;
   
-  curr = (char*)curr + Table_Step(t);
+  if (t->old isnt NULL and Table_Owns(t->old, curr)) {
+    return Table_Scan(t->old, Table_Index(t->old, curr) + 1);
+  }
   
-  while (true) {
-
-    if (curr > Table_Key(t, t->nslots-1)) { return Terminal;}
-    uint64_t h = *(uint64_t*)((char*)curr - 
-      sizeof(struct Header) - sizeof(uint64_t));
-    if (h isnt 0) { return curr; }
-    curr = (char*)curr + Table_Step(t);
+  curr = Table_Scan(t, Table_Index(t, curr) + 1);
+  if (curr is Terminal and t->old isnt NULL) {
+    curr = Table_Scan(t->old, 0);
   }
   
-  return Terminal;
+  return curr;
 }
 
 static var Table_Iter_Last(var self) {
-  
   struct Table* t = self;
   if (t->nitems is 0) { return Terminal; }
   
-  size_t i = t->nslots-1;
-  while (true) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      return Table_Key(t, i);
-    }
-    if (i == 0) { break; }
-    i--;
+  if (t->old isnt NULL) {
+    var curr = Table_Scan_Back(t->old, t->old->nslots);
+    if (curr isnt Terminal) { return curr; }
   }
   
-  return Terminal;
-  
+  return Table_Scan_Back(t, t->nslots);
 }
 
 static var Table_Iter_Prev(var self, var curr) {
   struct Table* t = self;
   
-  curr = (char*)curr - Table_Step(t);
-  
-  while (true) {
-
-    if (curr < Table_Key(t, 0)) { return Terminal; }
-    uint64_t h = *(uint64_t*)((char*)curr - 
-      sizeof(struct Header) - sizeof(uint64_t));
-    if (h isnt 0) { return curr; }
-    curr = (char*)curr - Table_Step(t);
+  if (t->old isnt NULL and Table_Owns(t->old, curr)) {
+    curr = Table_Scan_Back(t->old, Table_Index(t->old, curr));
+    if (curr isnt Terminal) { return curr; }
+    return Table_Scan_Back(t, t->nslots);
   }
   
-  return Terminal;
+  return Table_Scan_Back(t, Table_Index(t, curr));
 }
 
 static var Table_Iter_Type(var self) {
@@ -626,18 +772,14 @@ static var Table_Iter_Type(var self) {
 }
 
 static int Table_Show(var self, var output, int pos) {
-  struct Table* t = self;
   
   pos = print_to(output, pos, "<'Table' At 0x%p {", self);
   
-  size_t j =0;
-  for(size_t i = 0; i < t->nslots; i++) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      pos = print_to(output, pos, "%$:%$",
-        Table_Key(t, i), Table_Val(t, i));
-      if (j < Table_Len(t)-1) { pos = print_to(output, pos, ", "); }
-      j++;
-    }
+  var curr = Table_Iter_Init(self);
+  while (curr isnt Terminal) {
+    pos = print_to(output, pos, "%$:%$", curr, Table_Get(self, curr));
+    curr = Table_Iter_Next(self, curr);
+    if (curr isnt Terminal) { pos = print_to(output, pos, ", "); }
   }
   
   return print_to(output, pos, "}>");
@@ -663,11 +805,12 @@ static void Table_Resize(var self, size_t n) {
 }
 
 static void Table_Mark(var self, var gc, void(*f)(var,void*)) {
-  struct Table* t = self;
-  for(size_t i = 0; i < t->nslots; i++) {
-    if (Table_Key_Hash(t, i) isnt 0) {
-      f(gc, Table_Key(t, i));
-      f(gc, Table_Val(t, i));
+  for (struct Table* s = self; s isnt NULL; s = s->old) {
+    for(size_t i = 0; i < s->nslots; i++) {
+      if (Table_Full(s, i)) {
+        f(gc, Table_Key(s, i));
+        f(gc, Table_Val(s, i));
+      }
     }
   }
 }
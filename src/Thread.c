@@ -152,7 +152,7 @@ static struct Example* Thread_Examples(void) {
 
 static void Thread_New(var self, var args) {
   struct Thread* t = self;
-  t->func = empty(args) ? NULL : get(args, $I(0));
+  t->func = empty(args) ? NULL : args_get(args, 0);
   t->args = NULL;
   t->is_main = false;
   t->is_running = false;
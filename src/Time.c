@@ -52,15 +52,15 @@ static void DateTime_New(var self, var args) {
     dt->timestamp = now;
     
     // Override with arguments if provided
-    if (len(args) >= 1) dt->year = c_int(get(args, $I(0)));
-    if (len(args) >= 2) dt->month = c_int(get(args, $I(1)));
-    if (len(args) >= 3) dt->day = c_int(get(args, $I(2)));
-    if (len(args) >= 4) dt->hour = c_int(get(args, $I(3)));
-    if (len(args) >= 5) dt->minute = c_int(get(args, $I(4)));
-    if (len(args) >= 6) dt->second = c_int(get(args, $I(5)));
+    if (args_len(args) >= 1) dt->year = c_int(args_get(args, 0));
+    if (args_len(args) >= 2) dt->month = c_int(args_get(args, 1));
+    if (args_len(args) >= 3) dt->day = c_int(args_get(args, 2));
+    if (args_len(args) >= 4) dt->hour = c_int(args_get(args, 3));
+    if (args_len(args) >= 5) dt->minute = c_int(args_get(args, 4));
+    if (args_len(args) >= 6) dt->second = c_int(args_get(args, 5));
     
     // Recalculate timestamp if args were provided
-    if (len(args) >= 3) {
+    if (args_len(args) >= 3) {
         struct tm tm = {0};
         tm.tm_year = dt->year - 1900;
         tm.tm_mon = dt->month - 1;
@@ -98,9 +98,9 @@ static void Duration_New(var self, var args) {
     d->total_seconds = 0;
     d->microseconds = 0;
     
-    if (len(args) >= 1) {
+    if (args_len(args) >= 1) {
         // First argument is total seconds
-        double seconds = c_float(get(args, $I(0)));
+        double seconds = c_float(args_get(args, 0));
         d->total_seconds = (int64_t)seconds;
         d->microseconds = (int32_t)((seconds - d->total_seconds) * 1000000);
     }
@@ -131,13 +131,13 @@ static void TimeZone_New(var self, var args) {
     tz->offset_seconds = 0;
     tz->is_dst = false;
     
-    if (len(args) >= 1) {
-        const char* name = c_str(get(args, $I(0)));
+    if (args_len(args) >= 1) {
+        const char* name = c_str(args_get(args, 0));
         tz->name = malloc(strlen(name) + 1);
         strcpy(tz->name, name);
     }
-    if (len(args) >= 2) {
-        tz->offset_seconds = c_int(get(args, $I(1)));
+    if (args_len(args) >= 2) {
+        tz->offset_seconds = c_int(args_get(args, 1));
     }
 }
 
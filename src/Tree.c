@@ -166,22 +166,22 @@ static void Tree_Set(var self, var key, var val);
 
 static void Tree_New(var self, var args) {
   struct Tree* m = self;
-  m->ktype = get(args, $I(0));
-  m->vtype = get(args, $I(1));
+  m->ktype = args_get(args, 0);
+  m->vtype = args_get(args, 1);
   m->ksize = size(m->ktype);
   m->vsize = size(m->vtype);
   m->nitems = 0;
   m->root = NULL;
 
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
   if (nargs % 2 isnt 0) {
     throw(FormatError, 
       "Received non multiple of two argument count to Tree constructor.");
   }
   
   for(size_t i = 0; i < (nargs-2)/2; i++) {
-    var key = get(args, $I(2+(i*2)+0));
-    var val = get(args, $I(2+(i*2)+1));
+    var key = args_at(args, nargs, 2+(i*2)+0);
+    var val = args_at(args, nargs, 2+(i*2)+1);
     Tree_Set(m, key, val);
   }
   
@@ -65,6 +65,17 @@ static struct Method* Tuple_Methods(void) {
       "tuple", 
       "#define tuple(...)",
       "Construct a `Tuple` object on the stack."
+    }, {
+      "args_get", 
+      "size_t args_len(var args);\n"
+      "var args_get(var args, size_t i);\n"
+      "var args_at(var args, size_t n, size_t i);",
+      "Get the number of arguments in, or the `i`th argument of, the `args` "
+      "passed to a constructor. These are fast for the Tuples built by `new` "
+      "and fall back to `len` and `get` for any other collection. `args_at` "
+      "takes the number of arguments `n` already found with `args_len`, so "
+      "that loops over the arguments can be bounds checked without counting "
+      "them again."
     }, {NULL, NULL, NULL}
   };
   
@@ -73,7 +84,7 @@ static struct Method* Tuple_Methods(void) {
 
 static void Tuple_New(var self, var args) {
   struct Tuple* t = self;
-  size_t nargs = len(args);
+  size_t nargs = args_len(args);
   
   t->items = malloc(sizeof(var) * (nargs+1));
   
@@ -84,7 +95,7 @@ static void Tuple_New(var self, var args) {
 #endif
   
   for (size_t i = 0; i < nargs; i++) {
-    t->items[i] = get(args, $I(i));
+    t->items[i] = args_at(args, nargs, i);
   }
   
   t->items[nargs] = Terminal;
@@ -519,3 +530,51 @@ var Tuple = Cello(Tuple,
   Instance(Sort,     Tuple_Sort_By),
   Instance(Show,     Tuple_Show, NULL));
 
+/*
+**  Constructors are almost always passed the stack `Tuple` built by
+**  `new`, so these read its items directly rather than going via `get`,
+**  which would box the index and count the Tuple on every argument.
+*/
+
+size_t args_len(var args) {
+  if (type_of(args) is Tuple) { return Tuple_Len(args); }
+  return len(args);
+}
+
+var args_get(var args, size_t i) {
+  
+  if (type_of(args) isnt Tuple) { return get(args, $I(i)); }
+  
+  struct Tuple* t = args;
+  
+  /* Callers use small fixed indices, loops use `args_at` instead */
+  
+#if CELLO_BOUND_CHECK == 1
+  for (size_t j = 0; j <= i; j++) {
+    if (t->items[j] is Terminal) {
+      return throw(IndexOutOfBoundsError,
+        "Index '%i' out of bounds for Tuple of size %i.",
+        $I(i), $I(j));
+    }
+  }
+#endif
+  
+  return t->items[i];
+}
+
+var args_at(var args, size_t n, size_t i) {
+  
+  if (type_of(args) isnt Tuple) { return get(args, $I(i)); }
+  
+#if CELLO_BOUND_CHECK == 1
+  if (i >= n) {
+    return throw(IndexOutOfBoundsError,
+      "Index '%i' out of bounds for Tuple of size %i.", $I(i), $I(n));
+  }
+#else
+  (void)n;
+#endif
+  
+  struct Tuple* t = args;
+  return t->items[i];
+}
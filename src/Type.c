@@ -93,7 +93,12 @@ static const char* Type_Description(void) {
     "call a member of a class with an object `method` can be used."
     "\n\n"
     "To see if a type implements a class `type_implements` can be used. To "
-    "call a member of a class, implemented `type_method` can be used.";
+    "call a member of a class, implemented `type_method` can be used."
+    "\n\n"
+    "When compiled with GCC or Clang every use of `method` and `type_method` "
+    "keeps a small inline cache of the last type it dispatched on, so calls "
+    "which repeatedly see the same type skip the search for the class "
+    "instance. This can be disabled by defining `CELLO_NINLINE_CACHE`.";
 }
 
 static struct Example* Type_Examples(void) {
@@ -158,6 +163,102 @@ enum {
   CELLO_MAX_INSTANCES = 256
 };
 
+/*
+**  Type names are interned in a global table the first time they are
+**  hashed or compared, or when a type is constructed at runtime. Each
+**  distinct name maps to a single `TypeName` holding a copy of the name
+**  and its hash, which is then stored in the type header. This makes
+**  hashing a type a single load and checking two types for equality a
+**  pointer comparison, even for distinct type objects with the same name.
+**
+**  Interned names are never freed, so runtime types may be constructed
+**  from temporary strings.
+*/
+
+struct TypeName {
+  uint64_t hash;
+  char name[];
+};
+
+static struct TypeName** Type_Names = NULL;
+static size_t Type_Names_Size = 0;
+static size_t Type_Names_Count = 0;
+
+#if defined(CELLO_UNIX)
+static pthread_mutex_t Type_Names_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static void Type_Names_Lock(void) { pthread_mutex_lock(&Type_Names_Mutex); }
+static void Type_Names_Unlock(void) { pthread_mutex_unlock(&Type_Names_Mutex); }
+#elif defined(CELLO_WINDOWS)
+static SRWLOCK Type_Names_Mutex = SRWLOCK_INIT;
+static void Type_Names_Lock(void) { AcquireSRWLockExclusive(&Type_Names_Mutex); }
+static void Type_Names_Unlock(void) { ReleaseSRWLockExclusive(&Type_Names_Mutex); }
+#else
+static void Type_Names_Lock(void) {}
+static void Type_Names_Unlock(void) {}
+#endif
+
+static bool Type_Names_Resize(void) {
+  
+  size_t size = Type_Names_Size is 0 ? 64 : Type_Names_Size * 2;
+  struct TypeName** names = calloc(size, sizeof(struct TypeName*));
+  if (names is NULL) { return false; }
+  
+  for (size_t i = 0; i < Type_Names_Size; i++) {
+    if (Type_Names[i] is NULL) { continue; }
+    size_t j = Type_Names[i]->hash & (size - 1);
+    while (names[j] isnt NULL) { j = (j + 1) & (size - 1); }
+    names[j] = Type_Names[i];
+  }
+  
+  free(Type_Names);
+  Type_Names = names;
+  Type_Names_Size = size;
+  return true;
+}
+
+static struct TypeName* Type_Name_Intern(const char* name) {
+  
+  size_t len = strlen(name);
+  uint64_t hash = hash_data(name, len);
+  struct TypeName* n = NULL;
+  
+  Type_Names_Lock();
+  
+  if ((Type_Names_Count + 1) * 2 > Type_Names_Size
+  and not Type_Names_Resize()) {
+    goto end;
+  }
+  
+  size_t i = hash & (Type_Names_Size - 1);
+  while (Type_Names[i] isnt NULL) {
+    if (Type_Names[i]->hash is hash
+    and strcmp(Type_Names[i]->name, name) is 0) {
+      n = Type_Names[i];
+      goto end;
+    }
+    i = (i + 1) & (Type_Names_Size - 1);
+  }
+  
+  n = malloc(sizeof(struct TypeName) + len + 1);
+  if (n is NULL) { goto end; }
+  
+  n->hash = hash;
+  memcpy(n->name, name, len + 1);
+  Type_Names[i] = n;
+  Type_Names_Count++;
+  
+end:
+  Type_Names_Unlock();
+  
+#if CELLO_MEMORY_CHECK == 1
+  if (n is NULL) {
+    throw(OutOfMemoryError, "Cannot intern Type name, out of memory!");
+  }
+#endif
+  
+  return n;
+}
+
 static var Type_Alloc(void) {
 
   struct Header* head = calloc(1, 
@@ -179,38 +280,68 @@ static void Type_New(var self, var args) {
   
   struct Type* t = self;
 
-  var name = get(args, $I(0));
-  var size = get(args, $I(1));
+  var name = args_get(args, 0);
+  var size = args_get(args, 1);
+  size_t nargs = args_len(args);
   
 #if CELLO_MEMORY_CHECK == 1
-  if (len(args) - 2 > CELLO_MAX_INSTANCES) {
+  if (nargs - 2 > CELLO_MAX_INSTANCES) {
     throw(OutOfMemoryError,
       "Cannot construct 'Type' with %i instances, maximum is %i.",
-      $I(len(args)), $I(CELLO_MAX_INSTANCES));
+      $I(nargs), $I(CELLO_MAX_INSTANCES));
   }
 #endif  
   
+  struct TypeName* n = Type_Name_Intern(c_str(name));
+  
   size_t cache_entries = CELLO_CACHE_NUM / 3;
   for (size_t i = 0; i < cache_entries; i++) {
     t[i] = (struct Type){ NULL, NULL, NULL };
   }
   
-  t[cache_entries+0] = (struct Type){ NULL, "__Name", (var)c_str(name) };
+#if CELLO_CACHE == 1
+  ((var*)t)[CELLO_CACHE_NAME] = n;
+#endif
+  
+  t[cache_entries+0] = (struct Type){ Type, "__Name", n->name };
   t[cache_entries+1] = (struct Type){ NULL, "__Size", (var)(uintptr_t)c_int(size) };
   
-  for(size_t i = 2; i < len(args); i++) {
-    var ins = get(args, $I(i));
+  for(size_t i = 2; i < nargs; i++) {
+    var ins = args_at(args, nargs, i);
     t[CELLO_NBUILTINS-2+i] = (struct Type){
       NULL, (var)c_str(type_of(ins)), ins };
   }
   
-  t[CELLO_NBUILTINS+len(args)-2] = (struct Type){ NULL, NULL, NULL };
+  t[CELLO_NBUILTINS+nargs-2] = (struct Type){ NULL, NULL, NULL };
+}
+
+#if CELLO_CACHE == 1
+static void Type_Table_Del(var self);
+#endif
+
+static void Type_Del(var self) {
+#if CELLO_CACHE == 1
+  Type_Table_Del(self);
+#endif
 }
 
 static char* Type_Builtin_Name(struct Type* t) {
   return t[(CELLO_CACHE_NUM / 3)+0].inst;
 }
 
+#if CELLO_CACHE == 1
+static struct TypeName* Type_Interned(struct Type* t) {
+  
+  var* slot = &((var*)t)[CELLO_CACHE_NAME];
+  struct TypeName* n = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+  if (n isnt NULL) { return n; }
+  
+  n = Type_Name_Intern(Type_Builtin_Name(t));
+  __atomic_store_n(slot, (var)n, __ATOMIC_RELEASE);
+  return n;
+}
+#endif
+
 static size_t Type_Builtin_Size(struct Type* t) {
   return (size_t)t[(CELLO_CACHE_NUM / 3)+1].inst;
 }
@@ -220,13 +351,21 @@ static int Type_Show(var self, var output, int pos) {
 }
 
 static int Type_Cmp(var self, var obj) {
+  if (self is obj) { return 0; }
   struct Type* objt = cast(obj, Type);
+#if CELLO_CACHE == 1
+  if (Type_Interned(self) is Type_Interned(objt)) { return 0; }
+#endif
   return strcmp(Type_Builtin_Name(self), Type_Builtin_Name(objt));
 }
 
 static uint64_t Type_Hash(var self) {
+#if CELLO_CACHE == 1
+  return Type_Interned(self)->hash;
+#else
   const char* name = Type_Builtin_Name(self);
   return hash_data(name, strlen(name));
+#endif
 }
 
 static char* Type_C_Str(var self) {
@@ -309,7 +448,7 @@ var Type = CelloEmpty(Type,
   Instance(Assign,   Type_Assign),
   Instance(Copy,     Type_Copy),
   Instance(Alloc,    Type_Alloc, NULL),
-  Instance(New,      Type_New, NULL),
+  Instance(New,      Type_New, Type_Del),
   Instance(Cmp,      Type_Cmp),
   Instance(Hash,     Type_Hash),
   Instance(Show,     Type_Show, NULL),
@@ -342,16 +481,16 @@ static var Type_Scan(var self, var cls) {
   
 }
 
+static var Type_Instance(var self, var cls);
+
 static bool Type_Implements(var self, var cls) {
-  return Type_Scan(self, cls) isnt NULL;
+  return Type_Instance(self, cls) isnt NULL;
 }
 
 bool type_implements(var self, var cls) {
   return Type_Implements(self, cls);
 }
 
-static var Type_Instance(var self, var cls);
-
 static var Type_Method_At_Offset(
   var self, var cls, size_t offset, const char* method_name) {
 
@@ -385,7 +524,7 @@ var type_method_at_offset(
 }
 
 static bool Type_Implements_Method_At_Offset(var self, var cls, size_t offset) {
-  var inst = Type_Scan(self, cls);
+  var inst = Type_Instance(self, cls);
   if (inst is NULL) { return false; }
   var meth = *((var*)(((char*)inst) + offset));
   if (meth is NULL) { return false; }
@@ -403,52 +542,127 @@ bool type_implements_method_at_offset(var self, var cls, size_t offset) {
 **  and they could be in any order, so each time a linear 
 **  search must be done to find the correct instance.
 **
-**  We can remove the need for a linear search by placing
-**  some common class instances at known locations. These 
-**  are the _Type Cache Entries_ and are located at some
-**  preallocated space at the beginning of every type object.
+**  We can remove the need for a linear search by giving
+**  every class a small integer _Class Id_ the first time it
+**  is looked up, and giving every type a _Dispatch Table_
+**  indexed by these ids. Both are stored in some preallocated
+**  space at the beginning of every type object.
 **
-**  The only problem is that these instances are not filled 
-**  at compile type, so we must dynamically fill them if they
-**  are empty. But this can be done with a standard call to 
-**  `Type_Scan` the first time.
+**  The tables are filled lazily with a standard call to 
+**  `Type_Scan` the first time a class is looked up on a type,
+**  and classes which the type does not implement are filled 
+**  with `Terminal` so that failed lookups are also fast. The
+**  layout is public so that the `CELLO_INLINE` fast paths in
+**  the header can read these tables directly.
 **
-**  The main advantage of this method is that it gives the compiler
-**  a better chance of inlining the code up to the call of the 
-**  instance function pointer, and removes the overhead 
-**  associated with setting up the call to `Type_Scan` which is 
-**  too complex a call to be effectively inlined.
+**  Because types are shared between threads the tables are
+**  never resized in place. When a new class id does not fit,
+**  a larger copy is made and published atomically. The old
+**  table is kept alive, linked from the new one, so that any
+**  thread still reading it is safe, and it is only freed
+**  along with the type.
 **
 */
 
-#define Type_Cache_Entry(i, lit) \
-  if (cls is lit) { \
-    var inst = ((var*)self)[i]; \
-    if (inst is NULL) { \
-      inst = Type_Scan(self, lit); \
-      ((var*)self)[i] = inst; \
-    } \
-    return inst; \
+enum {
+  TYPE_TABLE_MIN = 64
+};
+
+#if CELLO_CACHE == 1
+
+static size_t Type_Class_Next = 0;
+
+static size_t Type_Class_Id(var cls) {
+  
+  var* slot = &((var*)cls)[CELLO_CACHE_ID];
+  size_t id = (size_t)__atomic_load_n(slot, __ATOMIC_RELAXED);
+  if (id isnt 0) { return id; }
+  
+  var curr = NULL;
+  var next = (var)__atomic_add_fetch(&Type_Class_Next, 1, __ATOMIC_RELAXED);
+  if (__atomic_compare_exchange_n(slot, &curr, next,
+    false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { curr = next; }
+  
+  return (size_t)curr;
+}
+
+static struct TypeTable* Type_Table_Reserve(var self, size_t id) {
+  
+  var* slot = &((var*)self)[CELLO_CACHE_TABLE];
+  struct TypeTable* table = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+  
+  while (table is NULL or id >= table->size) {
+    
+    size_t need = __atomic_load_n(&Type_Class_Next, __ATOMIC_RELAXED);
+    size_t size = table is NULL ? TYPE_TABLE_MIN : table->size;
+    while (size <= id or size <= need) { size *= 2; }
+    
+    struct TypeTable* next = calloc(1,
+      sizeof(struct TypeTable) + sizeof(var) * size);
+    
+#if CELLO_MEMORY_CHECK == 1
+    if (next is NULL) {
+      throw(OutOfMemoryError, "Cannot allocate Dispatch Table, out of memory!");
+    }
+#endif
+    
+    next->prev = table;
+    next->size = size;
+    if (table isnt NULL) {
+      memcpy(next->insts, table->insts, sizeof(var) * table->size);
+    }
+    
+    var curr = table;
+    if (__atomic_compare_exchange_n(slot, &curr, (var)next,
+      false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+      table = next;
+    } else {
+      free(next);
+      table = curr;
+    }
   }
+  
+  return table;
+}
+
+static var Type_Table_Fill(var self, var cls, size_t id) {
+  var inst = Type_Scan(self, cls);
+  struct TypeTable* table = Type_Table_Reserve(self, id);
+  __atomic_store_n(&table->insts[id],
+    inst is NULL ? Terminal : inst, __ATOMIC_RELAXED);
+  return inst;
+}
+
+static void Type_Table_Del(var self) {
+  struct TypeTable* table = ((var*)self)[CELLO_CACHE_TABLE];
+  while (table isnt NULL) {
+    struct TypeTable* prev = table->prev;
+    free(table);
+    table = prev;
+  }
+  ((var*)self)[CELLO_CACHE_TABLE] = NULL;
+}
+
+#endif
 
 static var Type_Instance(var self, var cls) {
 
 #if CELLO_CACHE == 1
-  Type_Cache_Entry( 0, Size);    Type_Cache_Entry( 1, Alloc);
-  Type_Cache_Entry( 2, New);     Type_Cache_Entry( 3, Assign);
-  Type_Cache_Entry( 4, Cmp);     Type_Cache_Entry( 5, Mark);
-  Type_Cache_Entry( 6, Hash);    Type_Cache_Entry( 7, Len);
-  Type_Cache_Entry( 8, Iter);    Type_Cache_Entry( 9, Push);
-  Type_Cache_Entry(10, Concat);  Type_Cache_Entry(11, Get);
-  Type_Cache_Entry(12, C_Str);   Type_Cache_Entry(13, C_Int);
-  Type_Cache_Entry(14, C_Float); Type_Cache_Entry(15, Current);
-  Type_Cache_Entry(16, Cast);    Type_Cache_Entry(17, Pointer);
-#endif
+  size_t id = Type_Class_Id(cls);
+  struct TypeTable* table = __atomic_load_n(
+    &((var*)self)[CELLO_CACHE_TABLE], __ATOMIC_ACQUIRE);
+  
+  if (table isnt NULL and id < table->size) {
+    var inst = __atomic_load_n(&table->insts[id], __ATOMIC_RELAXED);
+    if (inst isnt NULL) { return inst is Terminal ? NULL : inst; }
+  }
   
+  return Type_Table_Fill(self, cls, id);
+#else
   return Type_Scan(self, cls);
-}
+#endif
 
-#undef Type_Cache_Entry
+}
 
 var type_instance(var self, var cls) {
   return Type_Instance(self, cls);
@@ -515,6 +729,59 @@ bool implements_method_at_offset(var self, var cls, size_t offset) {
   return Type_Implements_Method_At_Offset(Type_Of(self), cls, offset);
 }
 
+#if CELLO_INLINE_CACHE == 1
+
+/*
+**  Call site caches are only filled on a miss. The writer first claims
+**  the cache by moving its version from even to odd, and if another
+**  thread is already filling it we just return the instance uncached.
+**  Once the type and instance are stored the version is bumped to the
+**  next even number, so a reader which sees the same even version on
+**  both sides of its loads is guaranteed a consistent pair, even if the
+**  type was changed away and back again in between.
+**
+**  Types constructed at runtime are marked by `Type_New` and never cached,
+**  as once deleted their address may be reused by some other type.
+*/
+
+static bool Type_Builtin_Runtime(struct Type* t) {
+  return t[(CELLO_CACHE_NUM / 3)+0].cls is Type;
+}
+
+static void Type_Inline_Cache_Set(
+  struct InlineCache* cache, var type, var inst) {
+  
+  if (inst is NULL or Type_Builtin_Runtime(type)) { return; }
+  
+  size_t version = __atomic_load_n(&cache->version, __ATOMIC_RELAXED);
+  if (version & 1) { return; }
+  if (__atomic_load_n(&cache->type, __ATOMIC_RELAXED) is type) { return; }
+  if (not __atomic_compare_exchange_n(&cache->version, &version, version + 1,
+    false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { return; }
+  
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&cache->type, type, __ATOMIC_RELAXED);
+  __atomic_store_n(&cache->inst, inst, __ATOMIC_RELAXED);
+  __atomic_store_n(&cache->version, version + 2, __ATOMIC_RELEASE);
+}
+
+var method_at_offset_cached(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method_name) {
+  var type = Type_Of(self);
+  var inst = Type_Method_At_Offset(type, cls, offset, method_name);
+  Type_Inline_Cache_Set(cache, type, inst);
+  return inst;
+}
+
+var type_method_at_offset_cached(struct InlineCache* cache,
+  var self, var cls, size_t offset, const char* method_name) {
+  var inst = Type_Method_At_Offset(self, cls, offset, method_name);
+  Type_Inline_Cache_Set(cache, self, inst);
+  return inst;
+}
+
+#endif
+
 static const char* Size_Name(void) {
   return "Size";
 }
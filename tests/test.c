@@ -1,6 +1,174 @@
 #include "../include/Cello.h"
 #include "ptest.h"
 
+/*
+**  Tests which expect objects to be collected create them in
+**  helpers called through volatile pointers, so they are never
+**  inlined, and then zero the stack those helpers used so the
+**  conservative stack scan cannot find stale pointers to them.
+*/
+
+static void stack_scrub(void) {
+  volatile char buffer[32 * 1024];
+  for (size_t i = 0; i < sizeof(buffer); i++) { buffer[i] = 0; }
+}
+
+static void (*volatile stack_scrub_call)(void) = stack_scrub;
+
+static void weak_fill(var items, var weaks, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    var x = new(Int, $I(i));
+    if (items isnt NULL) { push(items, $R(x)); }
+    push(weaks, $R(new(Weak, x)));
+  }
+}
+
+static void (*volatile weak_fill_call)(var, var, size_t) = weak_fill;
+
+static void ref_move(var from, var to) {
+  while (len(from) > 0) {
+    push(to, $R(deref(get(from, $I(0)))));
+    pop_at(from, $I(0));
+  }
+}
+
+static void (*volatile ref_move_call)(var, var) = ref_move;
+
+/* Arena */
+
+PT_FUNC(test_arena_alloc) {
+  
+  var a = new(Arena);
+  
+#ifndef CELLO_NGC
+  var gc = current(GC);
+  struct GCStats before, after;
+  gc_stats(gc, &before);
+#endif
+  
+  with (r in a) {
+    PT_ASSERT(current(Arena) is a);
+    PT_ASSERT(running(a));
+    for (int i = 0; i < 10000; i++) {
+      var x = new(Int, $I(i));
+      PT_ASSERT(c_int(x) is i);
+#ifndef CELLO_NGC
+      PT_ASSERT(not mem(gc, x));
+#endif
+    }
+    var s = new(String, $S("Hello"));
+    var l = new(Array, Int, $I(1), $I(2), $I(3));
+    PT_ASSERT(strcmp(c_str(s), "Hello") is 0);
+    PT_ASSERT(len(l) is 3);
+  }
+  
+#ifndef CELLO_NGC
+  gc_stats(gc, &after);
+  PT_ASSERT(after.objects_allocated is before.objects_allocated);
+#endif
+  
+  PT_ASSERT(current(Arena) is NULL);
+  PT_ASSERT(not running(a));
+  
+  del(a);
+  
+}
+
+PT_FUNC(test_arena_nested) {
+  
+  var a = new(Arena);
+  var b = new(Arena);
+  
+  start(a);
+  var x = new(Int, $I(1));
+  start(b);
+  PT_ASSERT(current(Arena) is b);
+  var y = new(Int, $I(2));
+  PT_ASSERT(c_int(x) + c_int(y) is 3);
+  stop(b);
+  PT_ASSERT(current(Arena) is a);
+  PT_ASSERT(c_int(x) is 1);
+  stop(a);
+  PT_ASSERT(current(Arena) is NULL);
+  
+  del(a); del(b);
+  
+}
+
+#ifndef CELLO_NGC
+PT_FUNC(test_arena_mark) {
+  
+  var gc = current(GC);
+  var items = new(Array, Ref);
+  var weaks = new(Array, Ref);
+  weak_fill_call(items, weaks, 1000);
+  
+  with (a in new(Arena)) {
+    
+    var held = new(Array, Ref);
+    ref_move_call(items, held);
+    
+    stack_scrub_call();
+    gc_collect(gc);
+    
+    for (int i = 0; i < 1000; i++) {
+      var x = deref(deref(get(weaks, $I(i))));
+      PT_ASSERT(x isnt NULL);
+      PT_ASSERT(c_int(x) is i);
+    }
+  }
+  
+  stack_scrub_call();
+  gc_collect(gc);
+  
+  size_t cleared = 0;
+  for (int i = 0; i < 1000; i++) {
+    if (deref(deref(get(weaks, $I(i)))) is NULL) { cleared++; }
+  }
+  PT_ASSERT(cleared > 900);
+  
+  del(items); del(weaks);
+  
+}
+#endif
+
+#if CELLO_ALLOC_CHECK == 1 && !defined(CELLO_NGC)
+PT_FUNC(test_arena_escape) {
+  
+  var keep = new(Array, Ref);
+  var a = new(Arena);
+  
+  start(a);
+  push(keep, $R(new(Int, $I(10))));
+  
+  volatile bool thrown = false;
+  try {
+    stop(a);
+  } catch (e in ResourceError) {
+    thrown = true;
+  }
+  
+  PT_ASSERT(thrown);
+  PT_ASSERT(not running(a));
+  PT_ASSERT(current(Arena) is NULL);
+  PT_ASSERT(c_int(deref(get(keep, $I(0)))) is 10);
+  
+  del(keep); del(a);
+  
+}
+#endif
+
+PT_SUITE(suite_arena) {
+  PT_REG(test_arena_alloc);
+  PT_REG(test_arena_nested);
+#ifndef CELLO_NGC
+  PT_REG(test_arena_mark);
+#endif
+#if CELLO_ALLOC_CHECK == 1 && !defined(CELLO_NGC)
+  PT_REG(test_arena_escape);
+#endif
+}
+
 /* Array */
 
 PT_FUNC(test_array_new) {
@@ -555,11 +723,24 @@ PT_FUNC(test_float_show) {
   
 }
 
+PT_FUNC(test_float_new) {
+  
+  var f0 = new_float(2.5);
+  
+  PT_ASSERT(type_of(f0) is Float);
+  PT_ASSERT( c_float(f0) == 2.5 );
+  PT_ASSERT( eq(f0, $F(2.5)) );
+  
+  del(f0);
+  
+}
+
 PT_SUITE(suite_float) {
   PT_REG(test_float_assign);
   PT_REG(test_float_c_float);
   PT_REG(test_float_cmp);
   PT_REG(test_float_hash);
+  PT_REG(test_float_new);
   PT_REG(test_float_show);
 }
 
@@ -646,6 +827,550 @@ PT_SUITE(suite_function) {
   PT_REG(test_function_call);
 }
 
+/* GC */
+
+#ifndef CELLO_NGC
+
+PT_FUNC(test_gc_generational) {
+  
+  var gc = current(GC);
+  set(gc, GCGenerational, $I(1));
+  set(gc, GCNursery, $I(8));
+  PT_ASSERT(mem(gc, GCGenerational));
+  
+  var a = new(Array, Box);
+  var t = new(Table, Int, Ref);
+  
+  for (size_t i = 0; i < 100; i++) { new(Int, $I(i)); }
+  
+  /* Young objects stored in old containers must survive */
+  for (size_t i = 0; i < 100; i++) {
+    push(a, $B(new(Int, $I(i))));
+    set(t, $I(i), $R(new(Float, $F(i))));
+  }
+  
+  for (size_t i = 0; i < 100; i++) { new(Int, $I(i)); }
+  
+  for (size_t i = 0; i < 100; i++) {
+    PT_ASSERT(c_int(deref(get(a, $I(i)))) is (int64_t)i);
+    PT_ASSERT(c_float(deref(get(t, $I(i)))) == (double)i);
+    PT_ASSERT(mem(gc, deref(get(a, $I(i)))));
+  }
+  
+  rem(gc, GCGenerational);
+  PT_ASSERT(not mem(gc, GCGenerational));
+  PT_ASSERT(mem(gc, GCNursery));
+  rem(gc, GCNursery);
+  
+  del(a);
+  del(t);
+  
+}
+
+PT_FUNC(test_gc_incremental) {
+  
+  var gc = current(GC);
+  set(gc, GCIncremental, $I(4));
+  PT_ASSERT(mem(gc, GCIncremental));
+  
+  var l = new(List, Box);
+  var t = new(Table, Int, Ref);
+  
+  /* Objects stored while a collection is in progress must survive */
+  for (size_t i = 0; i < 1000; i++) {
+    push(l, $B(new(Int, $I(i))));
+    set(t, $I(i), $R(new(Float, $F(i))));
+    new(Int, $I(i));
+  }
+  
+  join(gc);
+  
+  for (size_t i = 0; i < 1000; i++) {
+    PT_ASSERT(c_int(deref(get(l, $I(i)))) is (int64_t)i);
+    PT_ASSERT(c_float(deref(get(t, $I(i)))) == (double)i);
+    PT_ASSERT(mem(gc, deref(get(l, $I(i)))));
+  }
+  
+  set(gc, GCTimeBudget, $I(50));
+  PT_ASSERT(mem(gc, GCTimeBudget));
+  for (size_t i = 0; i < 1000; i++) { new(Int, $I(i)); }
+  rem(gc, GCTimeBudget);
+  PT_ASSERT(not mem(gc, GCTimeBudget));
+  
+  rem(gc, GCIncremental);
+  PT_ASSERT(not mem(gc, GCIncremental));
+  PT_ASSERT(c_int(deref(get(l, $I(999)))) is 999);
+  
+  del(l);
+  del(t);
+  
+}
+
+PT_FUNC(test_gc_deep) {
+  
+  /* Marking a long chain must not exhaust the C stack */
+  var head = new(Ref);
+  var node = head;
+  for (size_t i = 0; i < 200000; i++) {
+    var next = new(Ref);
+    ref(node, next);
+    node = next;
+  }
+  
+  for (size_t i = 0; i < 100000; i++) { new(Int, $I(i)); }
+  
+  size_t count = 0;
+  node = head;
+  while (deref(node) isnt NULL) {
+    PT_ASSERT(mem(current(GC), node));
+    node = deref(node);
+    count++;
+  }
+  
+  PT_ASSERT(count is 200000);
+  
+}
+
+PT_FUNC(test_gc_parallel) {
+  
+  var gc = current(GC);
+  set(gc, GCThreads, $I(4));
+  
+  var a = new(Array, Ref);
+  for (size_t i = 0; i < 100; i++) {
+    var l = new(List, Box);
+    for (size_t j = 0; j < 100; j++) {
+      push(l, $B(new(Int, $I(j))));
+    }
+    push(a, $R(l));
+  }
+  
+  for (size_t i = 0; i < 50000; i++) { new(Int, $I(i)); }
+  
+  for (size_t i = 0; i < 100; i++) {
+    var l = deref(get(a, $I(i)));
+    PT_ASSERT(mem(gc, l));
+    PT_ASSERT(len(l) is 100);
+    PT_ASSERT(c_int(deref(get(l, $I(99)))) is 99);
+  }
+  
+  rem(gc, GCThreads);
+  PT_ASSERT(not mem(gc, GCThreads));
+  
+}
+
+PT_FUNC(test_gc_sweeper) {
+  
+  var gc = current(GC);
+  set(gc, GCSweeper, $I(1));
+  
+  var a = new(Array, Ref);
+  for (size_t i = 0; i < 1000; i++) {
+    push(a, $R(new(String, $S("Live"))));
+  }
+  
+  for (size_t i = 0; i < 50000; i++) {
+    var x = new(String, $S("Temporary"));
+    var y = new(Int, $I(i));
+    if (i % 3 is 0) { del(x); }
+    if (i % 5 is 0) { del(y); }
+  }
+  
+  join(gc);
+  
+  for (size_t i = 0; i < 1000; i++) {
+    var s = deref(get(a, $I(i)));
+    PT_ASSERT(mem(gc, s));
+    PT_ASSERT_STR_EQ(c_str(s), "Live");
+  }
+  
+  rem(gc, GCSweeper);
+  PT_ASSERT(not mem(gc, GCSweeper));
+  
+}
+
+static size_t gc_hook_starts = 0;
+static size_t gc_hook_ends = 0;
+
+static void gc_hook_count(var gc, bool end) {
+  if (end) { gc_hook_ends++; } else { gc_hook_starts++; }
+}
+
+PT_FUNC(test_gc_stats) {
+  
+  var gc = current(GC);
+  join(gc);
+  gc_hook(gc, gc_hook_count);
+  
+  struct GCStats before, after;
+  gc_stats(gc, &before);
+  
+  for (size_t i = 0; i < 100000; i++) { new(Int, $I(i)); }
+  join(gc);
+  
+  gc_stats(gc, &after);
+  gc_hook(gc, NULL);
+  
+  PT_ASSERT(after.collections > before.collections);
+  PT_ASSERT(after.objects_allocated - before.objects_allocated >= 100000);
+  PT_ASSERT(after.objects_freed > before.objects_freed);
+  PT_ASSERT(after.bytes_allocated > before.bytes_allocated);
+  PT_ASSERT(after.pause_max > 0);
+  PT_ASSERT(after.pause_total >= after.pause_max);
+  PT_ASSERT(after.stack_size > 0);
+  PT_ASSERT(after.load_factor > 0.0 and after.load_factor <= 0.5);
+  
+  size_t total = 0;
+  for (size_t i = 0; i < 16; i++) { total += after.pause_histogram[i]; }
+  PT_ASSERT(total is after.pauses);
+  
+  PT_ASSERT(gc_hook_starts > 0);
+  PT_ASSERT(gc_hook_starts is gc_hook_ends);
+  
+}
+
+PT_FUNC(test_gc_growth) {
+  
+  var gc = current(GC);
+  struct GCStats before, after;
+  
+  gc_collect(gc);
+  set(gc, GCMinHeap, $I(50000));
+  gc_stats(gc, &before);
+  for (size_t i = 0; i < 20000; i++) { new(Int, $I(i)); }
+  gc_stats(gc, &after);
+  PT_ASSERT(after.collections is before.collections);
+  
+  gc_collect(gc);
+  gc_stats(gc, &after);
+  PT_ASSERT(after.collections is before.collections + 1);
+  PT_ASSERT(after.objects < before.objects + 20000);
+  rem(gc, GCMinHeap);
+  
+  set(gc, GCMaxBytes, $I(64 * 1024));
+  PT_ASSERT(mem(gc, GCMaxBytes));
+  gc_stats(gc, &before);
+  for (size_t i = 0; i < 20000; i++) { new(Int, $I(i)); }
+  gc_stats(gc, &after);
+  PT_ASSERT(after.collections > before.collections);
+  rem(gc, GCMaxBytes);
+  PT_ASSERT(not mem(gc, GCMaxBytes));
+  
+  var a = new(Array, Ref);
+  resize(gc, 100000);
+  gc_stats(gc, &before);
+  for (size_t i = 0; i < 100000; i++) { push(a, $R(new(Int, $I(i)))); }
+  gc_stats(gc, &after);
+  PT_ASSERT(after.collections is before.collections);
+  PT_ASSERT(c_int(deref(get(a, $I(99999)))) is 99999);
+  
+  set(gc, GCGrowth, $F(2.0));
+  rem(gc, GCGrowth);
+  
+}
+
+struct GCLayoutTest {
+  int64_t tag;
+  var child;
+  char* data;
+};
+
+static uint64_t GCLayoutTest_Layout(void) {
+  return layout_of(GCLayoutTest, child);
+}
+
+PT_FUNC(test_gc_layout) {
+  
+  var gc = current(GC);
+  var GCLayoutTest = new_root(Type,
+    $S("GCLayoutTest"),
+    $I(sizeof(struct GCLayoutTest)),
+    $(Layout, GCLayoutTest_Layout));
+  
+  struct Layout* l = type_instance(Int, Layout);
+  PT_ASSERT(l and l->layout() is 0);
+  PT_ASSERT(GCLayoutTest_Layout() is 2);
+  
+  var a = new(Array, Ref);
+  for (size_t i = 0; i < 1000; i++) {
+    struct GCLayoutTest* t = new(GCLayoutTest);
+    t->tag = i;
+    t->child = new(Int, $I(i));
+    t->data = "Not a Cello Object";
+    push(a, $R(t));
+    for (size_t j = 0; j < 20; j++) { new(String, $S("Temporary")); }
+  }
+  
+  gc_collect(gc);
+  
+  for (size_t i = 0; i < len(a); i++) {
+    struct GCLayoutTest* t = deref(get(a, $I(i)));
+    PT_ASSERT(mem(gc, t->child));
+    PT_ASSERT(c_int(t->child) is t->tag);
+    del(t);
+  }
+  
+  del(a);
+  del_root(GCLayoutTest);
+  
+}
+
+static void weak_table_fill(var t, var r, var keys) {
+  for (size_t i = 0; i < 1000; i++) {
+    var k = new(Int, $I(i));
+    set(t, $W(k), $R(i % 2 is 0 ? new(Int, $I(i)) : k));
+    set(r, $W(k), $I(i));
+    if (i % 4 is 0) { push(keys, $R(k)); }
+  }
+}
+
+static void (*volatile weak_table_fill_call)(var, var, var) = weak_table_fill;
+
+PT_FUNC(test_gc_weak) {
+  
+  var gc = current(GC);
+  var keep = new(Int, $I(-1));
+  var w = new(Weak, keep);
+  
+  var weaks = new(Array, Ref);
+  weak_fill_call(NULL, weaks, 1000);
+  
+  var t = new(Table, Weak, Ref);
+  var r = new(Tree, Weak, Int);
+  var keys = new(Array, Ref);
+  weak_table_fill_call(t, r, keys);
+  
+  stack_scrub_call();
+  gc_collect(gc);
+  
+  PT_ASSERT(deref(w) is keep);
+  
+  size_t cleared = 0;
+  for (size_t i = 0; i < len(weaks); i++) {
+    var v = deref(deref(get(weaks, $I(i))));
+    if (v is NULL) { cleared++; } else { PT_ASSERT(c_int(v) is (int64_t)i); }
+  }
+  PT_ASSERT(cleared > 900);
+  
+  PT_ASSERT(len(t) >= 250 and len(t) < 500);
+  PT_ASSERT(len(r) >= 250 and len(r) < 500);
+  for (size_t i = 0; i < len(keys); i++) {
+    var k = deref(get(keys, $I(i)));
+    PT_ASSERT(c_int(deref(get(t, $W(k)))) is c_int(k));
+    PT_ASSERT(c_int(get(r, $W(k))) is c_int(k));
+  }
+  
+  foreach (k in t) {
+    PT_ASSERT(deref(k) isnt NULL);
+    PT_ASSERT(mem(gc, deref(k)));
+  }
+  
+}
+
+static var gc_handoff_consume(var args) {
+  
+  var gc = current(GC);
+  var a = gc_adopt(gc, get(args, $I(0)));
+  var total = get(args, $I(1));
+  var out = get(args, $I(2));
+  
+  var reply = new(Array, Ref);
+  for (size_t i = 0; i < len(a); i++) {
+    var x = deref(get(a, $I(i)));
+    assign(total, $I(c_int(total) + c_int(x)));
+    push(reply, $R(new(Int, $I(c_int(x) * 2))));
+    new(String, $S("Temporary"));
+  }
+  
+  gc_collect(gc);
+  ref(out, gc_handoff(gc, reply));
+  return NULL;
+}
+
+static var gc_handoff_return(var args) {
+  var gc = current(GC);
+  var a = gc_adopt(gc, get(args, $I(0)));
+  ref(get(args, $I(1)), gc_handoff(gc, a));
+  return NULL;
+}
+
+PT_FUNC(test_gc_handoff) {
+  
+  var gc = current(GC);
+  struct GCStats before, after;
+  
+  var a = new(Array, Ref);
+  for (size_t i = 0; i < 1000; i++) {
+    push(a, $R(new(Int, $I(i))));
+  }
+  
+  gc_stats(gc, &before);
+  gc_handoff(gc, a);
+  gc_stats(gc, &after);
+  PT_ASSERT(after.objects is before.objects - 1001);
+  PT_ASSERT(not mem(gc, a));
+  
+  var total = $I(0);
+  var out = $R(NULL);
+  var t = new(Thread, $(Function, gc_handoff_consume));
+  call(t, a, total, out);
+  join(t);
+  del(t);
+  
+  PT_ASSERT(c_int(total) is 499500);
+  
+  var reply = gc_adopt(gc, deref(out));
+  PT_ASSERT(mem(gc, reply));
+  PT_ASSERT(len(reply) is 1000);
+  
+  for (size_t i = 0; i < 20000; i++) { new(String, $S("Temporary")); }
+  gc_collect(gc);
+  
+  for (size_t i = 0; i < len(reply); i++) {
+    var x = deref(get(reply, $I(i)));
+    PT_ASSERT(mem(gc, x));
+    PT_ASSERT(c_int(x) is (int64_t)i * 2);
+  }
+  
+  del(reply);
+  
+  /* Objects sent away and back again are home, not lent */
+  var back = new(Array, Ref);
+  var siblings = new(Array, Ref);
+  for (size_t i = 0; i < 1000; i++) {
+    push(back, $R(new(Int, $I(i))));
+    push(siblings, $R(new(Int, $I(i))));
+  }
+  
+  t = new(Thread, $(Function, gc_handoff_return));
+  call(t, gc_handoff(gc, back), out);
+  join(t);
+  del(t);
+  
+  back = gc_adopt(gc, deref(out));
+  PT_ASSERT(mem(gc, back));
+  
+  assign(total, $I(0));
+  t = new(Thread, $(Function, gc_handoff_consume));
+  call(t, gc_handoff(gc, back), total, out);
+  join(t);
+  del(t);
+  
+  PT_ASSERT(c_int(total) is 499500);
+  
+  for (size_t i = 0; i < len(siblings); i++) {
+    del(deref(get(siblings, $I(i))));
+  }
+  del(siblings);
+  
+  reply = gc_adopt(gc, deref(out));
+  for (size_t i = 0; i < len(reply); i++) {
+    PT_ASSERT(c_int(deref(get(reply, $I(i)))) is (int64_t)i * 2);
+  }
+  del(reply);
+  gc_collect(gc);
+  
+  volatile bool reached = false;
+  try {
+    gc_adopt(gc, $I(0));
+  } catch (e in ValueError) {
+    reached = true;
+  }
+  PT_ASSERT(reached);
+  
+}
+
+PT_FUNC(test_gc_slab) {
+  
+  var gc = current(GC);
+  PT_ASSERT(mem(gc, GCSlab));
+  
+  var a = new(Array, Ref);
+  for (size_t i = 0; i < 20000; i++) {
+    var x = new(Int, $I(i));
+    var y = new(Float, $F(i));
+    var z = new(Tuple, x, y);
+    var w = new(String, $S("Temporary"));
+    if (i % 10 is 0) { push(a, $R(z)); }
+    if (i % 3 is 0) { del(w); }
+  }
+  
+  for (size_t i = 0; i < len(a); i++) {
+    var z = deref(get(a, $I(i)));
+    PT_ASSERT(mem(gc, z));
+    PT_ASSERT(c_int(get(z, $I(0))) is (int64_t)i * 10);
+  }
+  
+  rem(gc, GCSlab);
+  PT_ASSERT(not mem(gc, GCSlab));
+  var x = new(Int, $I(1));
+  PT_ASSERT(mem(gc, x));
+  del(x);
+  set(gc, GCSlab, $I(1));
+  
+}
+
+PT_FUNC(test_gc_profile) {
+  
+  var gc = current(GC);
+  set(gc, GCProfile, $I(1));
+  PT_ASSERT(mem(gc, GCProfile));
+  
+  var items = new(Array, Ref);
+  for (size_t i = 0; i < 1000; i++) {
+    push(items, $R(new(Float, $F(i))));
+  }
+  
+  var out = new(String);
+  gc_snapshot(gc, out);
+  
+  const char* snap = c_str(out);
+  PT_ASSERT(strncmp(snap, "# Cello Heap Snapshot\n", 22) is 0);
+  
+  char* line = strstr(snap, "\nFloat\t");
+  PT_ASSERT(line isnt NULL);
+  long count = 0, bytes = 0, retained = 0;
+  PT_ASSERT(sscanf(line, "\nFloat\t%ld\t%ld\t%ld", 
+    &count, &bytes, &retained) is 3);
+  PT_ASSERT(count >= 1000);
+  PT_ASSERT(bytes >= 1000 * (long)size(Float));
+  
+  line = strstr(snap, "\nArray\t");
+  PT_ASSERT(line isnt NULL);
+  PT_ASSERT(sscanf(line, "\nArray\t%ld\t%ld\t%ld",
+    &count, &bytes, &retained) is 3);
+  PT_ASSERT(retained >= 1000 * (long)size(Float));
+  
+  PT_ASSERT(strstr(snap, "\n# site\ttype\tcount\tbytes\n") isnt NULL);
+  PT_ASSERT(strstr(snap, "\tFloat\t1000\t") isnt NULL);
+  
+  rem(gc, GCProfile);
+  PT_ASSERT(not mem(gc, GCProfile));
+  
+  del(out);
+  del(items);
+  
+}
+
+#endif
+
+PT_SUITE(suite_gc) {
+#ifndef CELLO_NGC
+  PT_REG(test_gc_generational);
+  PT_REG(test_gc_incremental);
+  PT_REG(test_gc_deep);
+  PT_REG(test_gc_parallel);
+  PT_REG(test_gc_sweeper);
+  PT_REG(test_gc_slab);
+  PT_REG(test_gc_stats);
+  PT_REG(test_gc_growth);
+  PT_REG(test_gc_layout);
+  PT_REG(test_gc_weak);
+  PT_REG(test_gc_handoff);
+  PT_REG(test_gc_profile);
+#endif
+}
+
 /* Int */
 
 PT_FUNC(test_int_assign) {
@@ -724,11 +1449,27 @@ PT_FUNC(test_int_show) {
   
 }
 
+PT_FUNC(test_int_new) {
+  
+  var i0 = new_int(34);
+  var i1 = new_int(-8213);
+  
+  PT_ASSERT(type_of(i0) is Int);
+  PT_ASSERT( c_int(i0) is 34 );
+  PT_ASSERT( c_int(i1) is -8213 );
+  PT_ASSERT( eq(i0, $I(34)) );
+  
+  del(i0);
+  del(i1);
+  
+}
+
 PT_SUITE(suite_int) {
   PT_REG(test_int_assign);
   PT_REG(test_int_c_int);
   PT_REG(test_int_cmp);
   PT_REG(test_int_hash);
+  PT_REG(test_int_new);
   PT_REG(test_int_show);
 }
 
@@ -1655,8 +2396,15 @@ PT_FUNC(test_string_new) {
   PT_ASSERT( not(s1 is s2) );
   PT_ASSERT_STR_EQ( c_str(s2), "There" );
   
+  var s3 = new_str("General");
+  PT_ASSERT(type_of(s3) is String);
+  PT_ASSERT_STR_EQ( c_str(s3), "General" );
+  append(s3, $S(" Kenobi"));
+  PT_ASSERT_STR_EQ( c_str(s3), "General Kenobi" );
+  
   del(s1);
   del(s2);
+  del(s3);
   
 }
 
@@ -1992,6 +2740,153 @@ PT_FUNC(test_table_rehash) {
   PT_ASSERT(len(t0) is max);
 
   del(t0);
+  
+  var t1 = new(Table, String, Int);
+  var k = new(String);
+  for (size_t i = 0; i < 300; i++) {
+    print_to(k, 0, "key%i", $I(i));
+    set(t1, k, $I(i));
+  }
+  
+  resize(t1, 5000);
+  
+  size_t count = 0;
+  var curr = iter_last(t1);
+  while (curr isnt Terminal) {
+    print_to(k, 0, "key%i", get(t1, curr));
+    PT_ASSERT(eq(curr, k));
+    curr = iter_prev(t1, curr);
+    count++;
+  }
+  PT_ASSERT(count is 300);
+  
+  del(t1); del(k);
+}
+
+PT_FUNC(test_table_churn) {
+  
+  var t0 = new(Table, Int, Int);
+  
+  for (int64_t round = 0; round < 4; round++) {
+    for (int64_t i = 0; i < 2000; i++) {
+      set(t0, $I(i), $I(i * 3 + round));
+    }
+    for (int64_t i = 0; i < 2000; i += 2) {
+      rem(t0, $I(i));
+    }
+    PT_ASSERT(len(t0) is 1000);
+    for (int64_t i = 0; i < 2000; i++) {
+      PT_ASSERT(mem(t0, $I(i)) is (i % 2 is 1));
+    }
+    PT_ASSERT(c_int(get(t0, $I(1999))) is 1999 * 3 + round);
+  }
+  
+  size_t count = 0;
+  foreach (key in t0) {
+    PT_ASSERT(c_int(key) % 2 is 1);
+    count++;
+  }
+  PT_ASSERT(count is 1000);
+  
+  var t1 = new(Table, Int, Int);
+  for (int64_t i = 0; i < 100; i++) {
+    set(t1, $I(i % 3), $I(i));
+    set(t1, $I(i % 3 + 3), $I(i));
+    rem(t1, $I(i % 3));
+    PT_ASSERT(not mem(t1, $I(i % 3)));
+    PT_ASSERT(c_int(get(t1, $I(i % 3 + 3))) is i);
+  }
+  PT_ASSERT(len(t1) is 3);
+  
+  del(t0); del(t1);
+  
+}
+
+PT_FUNC(test_table_migrate) {
+  
+  var t0 = new(Table, Int, Int);
+  
+  for (int64_t i = 0; i < 5000; i++) {
+    set(t0, $I(i), $I(i));
+    PT_ASSERT(mem(t0, $I(i / 2)));
+    PT_ASSERT(mem(t0, $I(i / 7)));
+    PT_ASSERT(c_int(get(t0, $I(i / 3))) is i / 3);
+    if (i % 250 is 0) {
+      size_t forward = 0, backward = 0;
+      foreach (key in t0) { forward++; }
+      var curr = iter_last(t0);
+      while (curr isnt Terminal) { backward++; curr = iter_prev(t0, curr); }
+      PT_ASSERT(forward is len(t0));
+      PT_ASSERT(backward is len(t0));
+    }
+  }
+  
+  var v = get(t0, $I(4999));
+  PT_ASSERT(mem(t0, $I(0)));
+  PT_ASSERT(c_int(get(t0, $I(2500))) is 2500);
+  PT_ASSERT(c_int(v) is 4999);
+  
+  for (int64_t i = 0; i < 4990; i++) {
+    rem(t0, $I(i));
+    PT_ASSERT(not mem(t0, $I(i)));
+    PT_ASSERT(mem(t0, $I(4999 - (i % 10))));
+  }
+  
+  PT_ASSERT(len(t0) is 10);
+  size_t count = 0;
+  foreach (key in t0) {
+    PT_ASSERT(c_int(key) >= 4990);
+    count++;
+  }
+  PT_ASSERT(count is 10);
+  
+  del(t0);
+  
+}
+
+/* Each value holds its own address, so moved entries can be counted */
+static size_t table_moved(var t) {
+  size_t moved = 0;
+  foreach (key in t) {
+    var val = get(t, key);
+    if (c_int(val) isnt (int64_t)(intptr_t)val) {
+      assign(val, $I((int64_t)(intptr_t)val));
+      moved++;
+    }
+  }
+  return moved;
+}
+
+PT_FUNC(test_table_migrate_churn) {
+  
+  /* Keys which all land near the start of the table, so that
+  ** removals leave tombstones which later moves then fill */
+  int64_t keys[4000];
+  size_t nkeys = 0;
+  for (int64_t k = 0; nkeys < 4000; k++) {
+    if (((uint32_t)hash_mix(hash($I(k))) & 0xFFFF) < 64) { keys[nkeys++] = k; }
+  }
+  
+  /* A migration step moves at most 256 entries, and only
+  ** finishing a migration early in one go moves more */
+  var t0 = new(Table, Int, Int);
+  size_t lo = 0;
+  for (size_t i = 0; i < nkeys; i++) {
+    set(t0, $I(keys[i]), $I(0));
+    PT_ASSERT(table_moved(t0) <= 257);
+    if (i % 2) {
+      rem(t0, $I(keys[lo++]));
+      PT_ASSERT(table_moved(t0) <= 256);
+    }
+  }
+  
+  PT_ASSERT(len(t0) is nkeys - lo);
+  for (size_t i = lo; i < nkeys; i++) {
+    PT_ASSERT(mem(t0, $I(keys[i])));
+  }
+  
+  del(t0);
+  
 }
 
 PT_SUITE(suite_table) {
@@ -2005,6 +2900,9 @@ PT_SUITE(suite_table) {
   PT_REG(test_table_resize);
   PT_REG(test_table_show);
   PT_REG(test_table_rehash);
+  PT_REG(test_table_churn);
+  PT_REG(test_table_migrate);
+  PT_REG(test_table_migrate_churn);
 }
 
 /* Thread */
@@ -2520,7 +3418,32 @@ PT_FUNC(test_tuple_new) {
   
   var x = new(Tuple, $I(100), $S("Test"));
   PT_ASSERT(x);
+  
+  PT_ASSERT(args_len(x) is 2);
+  PT_ASSERT(c_int(args_get(x, 0)) is 100);
+  PT_ASSERT_STR_EQ(c_str(args_get(x, 1)), "Test");
+  PT_ASSERT(args_len(tuple()) is 0);
+  PT_ASSERT_STR_EQ(c_str(args_at(x, 2, 1)), "Test");
+  
+#if CELLO_BOUND_CHECK == 1
+  volatile size_t caught = 0;
+  try { args_get(x, 2); } catch (e in IndexOutOfBoundsError) { caught++; }
+  try { args_get(x, 5); } catch (e in IndexOutOfBoundsError) { caught++; }
+  try { args_at(x, 2, 2); } catch (e in IndexOutOfBoundsError) { caught++; }
+  PT_ASSERT(caught is 3);
+#endif
+  
+  var a = new(Array, Int, $I(1), $I(2), $I(3));
+  PT_ASSERT(args_len(a) is 3);
+  PT_ASSERT(c_int(args_get(a, 2)) is 3);
+  
+  var y = new_with(Tuple, a);
+  PT_ASSERT(len(y) is 3);
+  PT_ASSERT(c_int(get(y, $I(1))) is 2);
+  
+  del(a);
   del(x);
+  del(y);
   
 }
 
@@ -2681,6 +3604,93 @@ PT_FUNC(test_type_show) {
   del(s);
 }
 
+static int TestType_Show_Foo(var self, var out, int pos) {
+  return print_to(out, pos, "Foo");
+}
+
+static int TestType_Show_Bar(var self, var out, int pos) {
+  return print_to(out, pos, "Bar");
+}
+
+PT_FUNC(test_type_method) {
+  
+  var s = new(String);
+  var objs[] = { $I(1), $F(2.5), $S("three"), Int };
+  const char* strs[] = { "1", "2.500000", "\"three\"", "Int" };
+  
+  for (size_t i = 0; i < 12; i++) {
+    show_to(objs[i % 4], s, 0);
+    PT_ASSERT_STR_EQ(c_str(s), strs[i % 4]);
+  }
+  
+  var Foo = new_root(Type, $S("Foo"), $I(sizeof(struct TestType)),
+    $(Show, TestType_Show_Foo, NULL));
+  var foo = new(Foo);
+  show_to(foo, s, 0);
+  PT_ASSERT_STR_EQ(c_str(s), "Foo");
+  del(foo);
+  del_root(Foo);
+  
+  var Bar = new_root(Type, $S("Bar"), $I(sizeof(struct TestType)),
+    $(Show, TestType_Show_Bar, NULL));
+  var bar = new(Bar);
+  show_to(bar, s, 0);
+  PT_ASSERT_STR_EQ(c_str(s), "Bar");
+  del(bar);
+  del_root(Bar);
+  
+  del(s);
+}
+
+PT_FUNC(test_type_instance) {
+  
+  static char names[100][16];
+  var classes[100];
+  
+  for (size_t i = 0; i < 100; i++) {
+    snprintf(names[i], 16, "TestClass%i", (int)i);
+    classes[i] = new_root(Type, $S(names[i]), $I(sizeof(var)));
+  }
+  
+  for (size_t j = 0; j < 2; j++) {
+    for (size_t i = 0; i < 100; i++) {
+      PT_ASSERT(not implements($I(1), classes[i]));
+      PT_ASSERT(instance($I(1), classes[i]) is NULL);
+      PT_ASSERT(implements($I(1), Show));
+      PT_ASSERT(implements($F(1), Cmp));
+      PT_ASSERT(not implements($F(1), Push));
+    }
+  }
+  
+  PT_ASSERT(instance($I(1), Cmp) is type_instance(Int, Cmp));
+  PT_ASSERT(type_implements(Array, Push));
+  PT_ASSERT(not type_implements(Int, Push));
+  
+  for (size_t i = 0; i < 100; i++) {
+    del_root(classes[i]);
+  }
+  
+}
+
+PT_FUNC(test_type_intern) {
+  
+  char buff[16];
+  strcpy(buff, "Int");
+  var Int2 = new_root(Type, $S(buff), $I(sizeof(struct Int)));
+  strcpy(buff, "Foo");
+  
+  PT_ASSERT_STR_EQ(c_str(Int2), "Int");
+  PT_ASSERT(Int2 isnt Int);
+  PT_ASSERT(eq(Int2, Int));
+  PT_ASSERT(hash(Int2) is hash(Int));
+  PT_ASSERT(hash(Int2) is hash($S("Int")));
+  PT_ASSERT(lt(Int2, Type));
+  PT_ASSERT(gt(Int2, Array));
+  
+  del_root(Int2);
+  
+}
+
 PT_SUITE(suite_type) {
   PT_REG(test_type_new);
   PT_REG(test_type_c_str);
@@ -2688,6 +3698,9 @@ PT_SUITE(suite_type) {
   PT_REG(test_type_hash);
   PT_REG(test_type_help);
   PT_REG(test_type_show);
+  PT_REG(test_type_method);
+  PT_REG(test_type_instance);
+  PT_REG(test_type_intern);
 }
 
 /* Zip */
@@ -2890,12 +3903,14 @@ PT_SUITE(suite_exception) {
 
 int main(int argc, char** argv) {
   
+  pt_add_suite(suite_arena);
   pt_add_suite(suite_array);
   pt_add_suite(suite_box);
   pt_add_suite(suite_file);
   pt_add_suite(suite_float);
   pt_add_suite(suite_filter);
   pt_add_suite(suite_function);
+  pt_add_suite(suite_gc);
   pt_add_suite(suite_int);
   pt_add_suite(suite_list);
   pt_add_suite(suite_map);